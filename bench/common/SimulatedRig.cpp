@@ -0,0 +1,80 @@
+#include "SimulatedRig.h"
+#include <EEPROM.h>
+
+SimulatedRig::SimulatedRig(const SimulatorConfig& config)
+    : simulator(config)
+    , driver(nullptr)
+    , encoder(nullptr)
+    , useStepTimer(true)
+{
+    Clock::install(&clock);
+    Serial.setStdinEnabled(false);
+    Serial.setCapture(&serialSink, false);
+}
+
+SimulatedRig::~SimulatedRig() {
+    controller.reset();
+    Serial.setCapture(nullptr);
+    Clock::install(nullptr);
+}
+
+bool SimulatedRig::start(uint8_t filterCount, bool withEncoder) {
+    controller.reset();
+    EEPROM.clear();
+    simulator.reset();
+
+    driver = new SimulatedMotorDriver(simulator);
+    driver->init();
+    encoder = new SimulatedEncoder(simulator);
+
+    controller.reset(new FilterWheelController());
+    bool ok = controller->init(std::unique_ptr<MotorDriver>(driver),
+                               std::unique_ptr<EncoderInterface>(encoder));
+    if (!ok) {
+        return false;
+    }
+
+    if (useStepTimer) {
+        controller->setStepTimer(std::unique_ptr<StepTimer>(new SimulatedStepTimer(&clock)));
+    }
+
+    if (!withEncoder) {
+        encoder->setAvailable(false);
+    }
+
+    controller->setFilterCount(filterCount);
+    controller->setCurrentPosition(1);
+    serialSink.clear();
+    return true;
+}
+
+bool SimulatedRig::moveAndWait(uint8_t position) {
+    if (!controller->moveToPosition(position)) {
+        return false;
+    }
+
+    waitForIdle();
+    return controller->getLastMoveStats().success;
+}
+
+void SimulatedRig::waitForIdle() {
+    // Same cadence as the firmware loop()
+    while (controller->isMotorMoving()) {
+        controller->update();
+        clock.delay(1);
+    }
+}
+
+float SimulatedRig::wheelErrorTo(uint8_t position) {
+    float target = controller->positionToAngle(position);
+    float error = target - simulator.getWheelAngle();
+    while (error > 180.0f) error -= 360.0f;
+    while (error < -180.0f) error += 360.0f;
+    return error;
+}
+
+std::string SimulatedRig::takeSerialOutput() {
+    std::string out;
+    out.swap(serialSink);
+    return out;
+}
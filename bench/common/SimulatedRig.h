@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Arduino.h>
+#include "core/Clock.h"
+#include "core/FilterWheelController.h"
+#include "simulation/FilterWheelSimulator.h"
+#include "simulation/SimulatedMotorDriver.h"
+#include "simulation/SimulatedEncoder.h"
+#include "simulation/SimulatedStepTimer.h"
+#include <memory>
+#include <string>
+
+/**
+ * Controller + simulated mechanism on virtual time, for host benchmarks
+ * Firmware serial output is swallowed so benchmark reports stay readable.
+ */
+class SimulatedRig {
+public:
+    SimulatedClock clock;
+    FilterWheelSimulator simulator;
+    std::unique_ptr<FilterWheelController> controller;
+    SimulatedMotorDriver* driver;
+    SimulatedEncoder* encoder;
+    bool useStepTimer;      // Timer-driven steps (default) or polled from the loop
+
+    explicit SimulatedRig(const SimulatorConfig& config = SimulatorConfig());
+    ~SimulatedRig();
+
+    /**
+     * Build a fresh controller (blank EEPROM) with the given filter count
+     * @param withEncoder false to exercise the step-based fallback
+     */
+    bool start(uint8_t filterCount, bool withEncoder = true);
+
+    /**
+     * Start a move and run the firmware main loop until it finishes
+     * @return true if the move started and completed successfully
+     */
+    bool moveAndWait(uint8_t position);
+
+    /**
+     * Run the firmware main loop until the controller is idle again
+     * (a move, or a revolution calibration and its return move)
+     */
+    void waitForIdle();
+
+    /**
+     * True mechanical error to a filter position (degrees, signed)
+     */
+    float wheelErrorTo(uint8_t position);
+
+    /**
+     * Output written by the firmware since the last call
+     */
+    std::string takeSerialOutput();
+
+private:
+    std::string serialSink;
+};
+
+/**
+ * Milliseconds of virtual time elapsed since a reference point
+ */
+inline unsigned long elapsedMs(SimulatedClock& clock, unsigned long startMs) {
+    return clock.millis() - startMs;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * Sample collection with nearest-rank percentiles
+ */
+class Stats {
+public:
+    void add(double value) { samples.push_back(value); sorted = false; }
+    size_t count() const { return samples.size(); }
+
+    double percentile(double p) {
+        if (samples.empty()) return 0.0;
+        sort();
+        size_t rank = (size_t)(p / 100.0 * samples.size() + 0.999999);
+        if (rank < 1) rank = 1;
+        if (rank > samples.size()) rank = samples.size();
+        return samples[rank - 1];
+    }
+
+    double max() {
+        if (samples.empty()) return 0.0;
+        sort();
+        return samples.back();
+    }
+
+    double mean() const {
+        if (samples.empty()) return 0.0;
+        double sum = 0.0;
+        for (double v : samples) sum += v;
+        return sum / samples.size();
+    }
+
+    double total() const {
+        double sum = 0.0;
+        for (double v : samples) sum += v;
+        return sum;
+    }
+
+private:
+    std::vector<double> samples;
+    bool sorted = false;
+
+    void sort() {
+        if (!sorted) {
+            std::sort(samples.begin(), samples.end());
+            sorted = true;
+        }
+    }
+};
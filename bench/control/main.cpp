@@ -0,0 +1,190 @@
+/**
+ * Encoder control benchmark: iterative PID vs continuous tracking vs
+ * feedforward (one calibrated move plus encoder correction)
+ *
+ * Runs every ordered pair of positions for 3-9 filters on the simulated
+ * mechanism with each encoder control mode and reports move time,
+ * iterations and final error. Times are mechanism (virtual) time.
+ *
+ * --backlash sets the simulated gear play (steps); --measure runs the
+ * backlash calibration first so reversals are compensated. --autotune
+ * replaces the default PID gains with relay-tuned ones before measuring.
+ * --microsteps drives the mechanism with N step pulses per full step, as
+ * a TMC driver does (the controller plans in microsteps). --binding adds a
+ * tight spot (extra friction, in steps/s²) over 60° of the turn where the
+ * motor slips at speed, to exercise the step-loss monitor; --no-monitor
+ * turns the monitor off for comparison.
+ *
+ * Usage: program [--csv] [--filters N] [--backlash STEPS] [--measure] [--autotune]
+ *                [--microsteps N] [--binding FRICTION] [--no-monitor]
+ */
+
+#include "SimulatedRig.h"
+#include "Stats.h"
+#include "config.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+namespace {
+
+typedef FilterWheelController::EncoderControlMode ControlMode;
+
+struct ModeResult {
+    Stats timeMs;
+    Stats iterations;
+    Stats errorDeg;
+    int failures = 0;
+    int slipped = 0;        // Moves in which the monitor saw lost steps
+};
+
+const char* modeName(ControlMode mode) {
+    switch (mode) {
+        case ControlMode::TRACKING:    return "tracking";
+        case ControlMode::FEEDFORWARD: return "feedfwd";
+        default:                       return "iterative";
+    }
+}
+
+void runMode(SimulatedRig& rig, uint8_t filterCount, ControlMode mode, bool measure,
+             bool autotune, bool monitor, bool csv, ModeResult& result) {
+    rig.start(filterCount, true);
+    FilterWheelController& controller = *rig.controller;
+    controller.setEncoderControlMode(mode);
+    controller.setStepLossDetectionEnabled(monitor);
+
+    if (measure) {
+        controller.startBacklashCalibration();
+        rig.waitForIdle();
+        controller.clearError();
+    }
+    if (autotune) {
+        controller.startPidAutotune();
+        rig.waitForIdle();
+        controller.clearError();
+    }
+
+    for (uint8_t from = 1; from <= filterCount; from++) {
+        for (uint8_t to = 1; to <= filterCount; to++) {
+            if (from == to) continue;
+
+            if (controller.getCurrentPosition() != from) {
+                rig.moveAndWait(from);
+                controller.clearError();
+            }
+
+            bool ok = rig.moveAndWait(to);
+            const FilterWheelController::MoveStats& stats = controller.getLastMoveStats();
+            float error = rig.wheelErrorTo(to);
+
+            result.timeMs.add(stats.durationMs);
+            result.iterations.add(stats.iterations);
+            result.errorDeg.add(fabsf(error));
+            if (!ok || !stats.usedEncoder) {
+                result.failures++;
+            }
+            if (stats.stepsLost > 0) {
+                result.slipped++;
+            }
+
+            if (csv) {
+                printf("%s,%u,%u,%u,%lu,%u,%.3f,%d,%ld\n", modeName(mode), filterCount, from, to,
+                       stats.durationMs, stats.iterations, error, ok ? 1 : 0, stats.stepsLost);
+            }
+            controller.clearError();
+        }
+    }
+    rig.takeSerialOutput();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool csv = false;
+    bool measure = false;
+    bool autotune = false;
+    bool monitor = true;
+    int onlyFilters = 0;
+    SimulatorConfig config;
+    config.encoderOffsetDegrees = 0.0f;  // Wheel mounted as calibrated
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (strcmp(argv[i], "--filters") == 0 && i + 1 < argc) {
+            onlyFilters = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--backlash") == 0 && i + 1 < argc) {
+            config.backlashSteps = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--measure") == 0) {
+            measure = true;
+        } else if (strcmp(argv[i], "--autotune") == 0) {
+            autotune = true;
+        } else if (strcmp(argv[i], "--microsteps") == 0 && i + 1 < argc) {
+            config.microsteps = (uint16_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--binding") == 0 && i + 1 < argc) {
+            config.bindingFriction = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--no-monitor") == 0) {
+            monitor = false;
+        }
+    }
+    config.bindingSteps = config.stepsPerRevolution * 100.0f / 360.0f;
+    config.bindingWidthSteps = config.stepsPerRevolution * 60.0f / 360.0f;
+    SimulatedRig rig(config);
+
+    const ControlMode modes[] = {ControlMode::ITERATIVE, ControlMode::TRACKING,
+                                 ControlMode::FEEDFORWARD};
+    const int modeCount = sizeof(modes) / sizeof(modes[0]);
+    ModeResult results[modeCount][10];
+    ModeResult totals[modeCount];
+
+    if (csv) {
+        printf("mode,filters,from,to,time_ms,iterations,error_deg,ok,steps_lost\n");
+    }
+
+    for (int m = 0; m < modeCount; m++) {
+        for (uint8_t n = MIN_FILTER_COUNT; n <= MAX_FILTER_COUNT; n++) {
+            if (onlyFilters && n != onlyFilters) continue;
+            runMode(rig, n, modes[m], measure, autotune, monitor, csv, results[m][n]);
+        }
+    }
+
+    if (csv) {
+        return 0;
+    }
+
+    printf("Encoder control latency, %.0f steps backlash %s, %s PID gains, %u microsteps (simulated mechanism time)\n",
+           config.backlashSteps, measure ? "measured" : "uncompensated",
+           autotune ? "autotuned" : "default", config.microsteps);
+    printf("%-9s %2s %5s | %7s %7s %7s | %4s %4s | %6s %6s | %s\n",
+           "mode", "N", "moves", "t50ms", "t95ms", "tmax", "it50", "itmx", "err50", "errmx", "fail");
+    for (uint8_t n = MIN_FILTER_COUNT; n <= MAX_FILTER_COUNT; n++) {
+        if (onlyFilters && n != onlyFilters) continue;
+        for (int m = 0; m < modeCount; m++) {
+            ModeResult& r = results[m][n];
+            printf("%-9s %2u %5zu | %7.0f %7.0f %7.0f | %4.0f %4.0f | %6.2f %6.2f | %d\n",
+                   modeName(modes[m]), n, r.timeMs.count(),
+                   r.timeMs.percentile(50), r.timeMs.percentile(95), r.timeMs.max(),
+                   r.iterations.percentile(50), r.iterations.max(),
+                   r.errorDeg.percentile(50), r.errorDeg.max(), r.failures);
+            totals[m].timeMs.add(r.timeMs.mean());
+            totals[m].iterations.add(r.iterations.mean());
+            totals[m].failures += r.failures;
+            totals[m].slipped += r.slipped;
+        }
+    }
+
+    // Relative to the iterative PID loop
+    double iterativeMs = totals[0].timeMs.mean();
+    double iterativeIt = totals[0].iterations.mean();
+    printf("\n");
+    for (int m = 0; m < modeCount; m++) {
+        double ms = totals[m].timeMs.mean();
+        double it = totals[m].iterations.mean();
+        printf("Mean %-9s %5.0f ms, %.1f iterations (%.0f%% less time, %.0f%% fewer iterations), "
+               "%d moves slipped\n",
+               modeName(modes[m]), ms, it,
+               iterativeMs > 0 ? 100.0 * (iterativeMs - ms) / iterativeMs : 0.0,
+               iterativeIt > 0 ? 100.0 * (iterativeIt - it) / iterativeIt : 0.0,
+               totals[m].slipped);
+    }
+    return 0;
+}
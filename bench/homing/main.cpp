@@ -0,0 +1,149 @@
+/**
+ * Sensorless homing benchmark
+ *
+ * Powers up a 5-slot wheel without the encoder at positions spread over
+ * its travel, with a saved filter that no longer matches the wheel, and
+ * homes it against the simulated hard stop (HOMING_ORIGIN_ANGLE past
+ * filter 1). Reports homing time, the true error at the saved filter
+ * afterwards, and the worst error and stop contacts over a refocus
+ * sequence run from that origin. Times are mechanism (virtual) time.
+ *
+ * --microsteps drives the mechanism with N step pulses per full step, as
+ * a TMC driver does. --no-stop removes the stop: every homing must fail.
+ *
+ * Usage: program [--csv] [--starts N] [--microsteps N] [--no-stop]
+ */
+
+#include "SimulatedRig.h"
+#include "Stats.h"
+#include "config.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+namespace {
+
+// Refocus on filter 1 before every other filter
+const uint8_t REFOCUS[] = {1, 2, 1, 3, 1, 4, 1, 5, 1, 2, 1, 3, 1, 4, 1, 5, 1};
+
+struct HomingRun {
+    bool homed = false;
+    unsigned long timeMs = 0;
+    float errorDeg = 0.0f;          // At the saved filter after homing
+    float sequenceMaxError = 0.0f;  // Worst error over the refocus sequence
+    long stopSlips = 0;             // Steps lost at the stop during the sequence
+    int failures = 0;
+};
+
+HomingRun runHoming(SimulatedRig& rig, float startSteps, uint8_t savedPosition) {
+    HomingRun run;
+    rig.simulator.getConfig().initialWheelSteps = startSteps;
+    rig.start(5, false);
+    FilterWheelController& controller = *rig.controller;
+    controller.setBacklashSteps((int)rig.simulator.getConfig().backlashSteps *
+                                rig.simulator.getConfig().microsteps);
+    controller.setCurrentPosition(savedPosition);
+
+    unsigned long startMs = rig.clock.millis();
+    if (!controller.startSensorlessHoming()) {
+        return run;
+    }
+    rig.waitForIdle();
+    run.timeMs = elapsedMs(rig.clock, startMs);
+    run.homed = controller.isHomedToStop() && controller.getErrorCode() == 0;
+    if (!run.homed) {
+        controller.clearError();
+        return run;
+    }
+    run.errorDeg = rig.wheelErrorTo(savedPosition);
+
+    // Moves from the homed origin must never run into the stop
+    long missedBefore = rig.simulator.getMissedSteps();
+    for (uint8_t to : REFOCUS) {
+        if (controller.getCurrentPosition() == to) continue;
+        if (!rig.moveAndWait(to)) run.failures++;
+        float error = fabsf(rig.wheelErrorTo(to));
+        if (error > run.sequenceMaxError) run.sequenceMaxError = error;
+    }
+    run.stopSlips = labs(rig.simulator.getMissedSteps() - missedBefore);
+    rig.takeSerialOutput();
+    return run;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool csv = false;
+    bool hardStop = true;
+    int starts = 12;
+    SimulatorConfig config;
+    config.encoderOffsetDegrees = 0.0f;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (strcmp(argv[i], "--starts") == 0 && i + 1 < argc) {
+            starts = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--microsteps") == 0 && i + 1 < argc) {
+            config.microsteps = (uint16_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--no-stop") == 0) {
+            hardStop = false;
+        }
+    }
+
+    // Filter 1 sits at wheel angle 0, the stop HOMING_ORIGIN_ANGLE past it
+    float stepsPerDegree = config.stepsPerRevolution / 360.0f;
+    config.hardStop = hardStop;
+    config.hardStopSteps = HOMING_DIRECTION * HOMING_ORIGIN_ANGLE * stepsPerDegree;
+    SimulatedRig rig(config);
+
+    if (csv) {
+        printf("start_deg,saved,homed,time_ms,error_deg,seq_error_deg,stop_slips,failures\n");
+    } else {
+        printf("Sensorless homing, 5-slot wheel, stop %.1f° %s of filter 1, %u steps/rev x%u "
+               "(simulated mechanism time)\n", HOMING_ORIGIN_ANGLE,
+               HOMING_DIRECTION > 0 ? "forward" : "backward",
+               config.stepsPerRevolution, config.microsteps);
+        printf("%9s %5s | %5s %8s | %7s | %9s %10s | %s\n",
+               "start_deg", "saved", "homed", "time_ms", "err_deg", "seq_errmx", "stop_slips", "fail");
+    }
+
+    Stats timeMs;
+    Stats errorDeg;
+    int notHomed = 0;
+    int failures = 0;
+    long slips = 0;
+    for (int i = 0; i < starts; i++) {
+        // Spread over the travel between both faces of the stop
+        float fromStop = (i + 0.5f) / starts * config.stepsPerRevolution;
+        float startSteps = config.hardStopSteps - HOMING_DIRECTION * fromStop;
+        float startDeg = fmodf(startSteps / stepsPerDegree + 360.0f, 360.0f);
+        uint8_t saved = (uint8_t)(1 + (i * 3) % 5);
+
+        HomingRun run = runHoming(rig, startSteps, saved);
+        if (run.homed) {
+            timeMs.add(run.timeMs);
+            errorDeg.add(fabsf(run.errorDeg));
+        } else {
+            notHomed++;
+        }
+        failures += run.failures;
+        slips += run.stopSlips;
+
+        if (csv) {
+            printf("%.1f,%u,%d,%lu,%.3f,%.3f,%ld,%d\n", startDeg, saved, run.homed ? 1 : 0,
+                   run.timeMs, run.errorDeg, run.sequenceMaxError, run.stopSlips, run.failures);
+        } else {
+            printf("%9.1f %5u | %5s %8lu | %7.2f | %9.2f %10ld | %d\n", startDeg, saved,
+                   run.homed ? "yes" : "NO", run.timeMs, run.errorDeg,
+                   run.sequenceMaxError, run.stopSlips, run.failures);
+        }
+    }
+
+    if (!csv) {
+        printf("\nHomed %d/%d, time mean %.0f ms max %.0f ms, error mean %.2f° max %.2f°, "
+               "%ld steps lost at the stop after homing, %d failed moves\n",
+               starts - notHomed, starts, timeMs.mean(), timeMs.max(),
+               errorDeg.mean(), errorDeg.max(), slips, failures);
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * Filter-change latency benchmark
+ *
+ * Drives FilterWheelController::moveToPosition() through every ordered pair
+ * of positions for 3-9 filters on the simulated mechanism, in encoder mode
+ * and in the step-based fallback. Times are virtual time on the simulated
+ * clock, i.e. what the move would take on the mechanism, not host run time.
+ *
+ * Usage: program [--csv] [--filters N] [--jerk J] [--polled]
+ *   --jerk    S-curve jerk limit in steps/s³ (default: trapezoidal)
+ *   --polled  Step from the 1 ms main loop instead of the timer callback
+ */
+
+#include "SimulatedRig.h"
+#include "Stats.h"
+#include "config.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+namespace {
+
+struct ModeResult {
+    Stats timeMs;
+    Stats iterations;
+    Stats errorDeg;
+    Stats steps;
+    int failures = 0;
+};
+
+void runMode(SimulatedRig& rig, uint8_t filterCount, bool withEncoder, float jerk, bool csv, ModeResult& result) {
+    const char* mode = withEncoder ? "encoder" : "steps";
+    rig.start(filterCount, withEncoder);
+    FilterWheelController& controller = *rig.controller;
+    controller.getStepGenerator()->setJerk(jerk);
+
+    for (uint8_t from = 1; from <= filterCount; from++) {
+        for (uint8_t to = 1; to <= filterCount; to++) {
+            if (from == to) continue;
+
+            if (controller.getCurrentPosition() != from) {
+                rig.moveAndWait(from);
+                controller.clearError();
+            }
+
+            bool ok = rig.moveAndWait(to);
+            const FilterWheelController::MoveStats& stats = controller.getLastMoveStats();
+            float error = rig.wheelErrorTo(to);
+
+            result.timeMs.add(stats.durationMs);
+            result.iterations.add(stats.iterations);
+            result.errorDeg.add(fabsf(error));
+            result.steps.add(stats.stepsIssued);
+            if (!ok || (withEncoder && !stats.usedEncoder)) {
+                result.failures++;
+            }
+
+            if (csv) {
+                printf("%s,%u,%u,%u,%lu,%u,%.3f,%ld,%d\n", mode, filterCount, from, to,
+                       stats.durationMs, stats.iterations, error, stats.stepsIssued, ok ? 1 : 0);
+            }
+            controller.clearError();
+        }
+    }
+    rig.takeSerialOutput();
+}
+
+void printSummary(const char* mode, uint8_t filterCount, ModeResult& r) {
+    printf("%-8s %2u %5zu | %7.0f %7.0f %7.0f | %4.0f %4.0f %4.0f | %6.2f %6.2f %6.2f | %6.0f %6.0f | %d\n",
+           mode, filterCount, r.timeMs.count(),
+           r.timeMs.percentile(50), r.timeMs.percentile(95), r.timeMs.max(),
+           r.iterations.percentile(50), r.iterations.percentile(95), r.iterations.max(),
+           r.errorDeg.percentile(50), r.errorDeg.percentile(95), r.errorDeg.max(),
+           r.steps.percentile(50), r.steps.max(),
+           r.failures);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool csv = false;
+    int onlyFilters = 0;
+    float jerk = 0.0f;
+    bool polled = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (strcmp(argv[i], "--filters") == 0 && i + 1 < argc) {
+            onlyFilters = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--jerk") == 0 && i + 1 < argc) {
+            jerk = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--polled") == 0) {
+            polled = true;
+        }
+    }
+
+    SimulatorConfig config;
+    config.encoderOffsetDegrees = 0.0f;  // Wheel mounted as calibrated
+    SimulatedRig rig(config);
+    rig.useStepTimer = !polled;
+
+    const bool modes[] = {true, false};
+    ModeResult results[2][10];
+
+    if (csv) {
+        printf("mode,filters,from,to,time_ms,iterations,error_deg,steps,ok\n");
+    }
+
+    for (int m = 0; m < 2; m++) {
+        for (uint8_t n = MIN_FILTER_COUNT; n <= MAX_FILTER_COUNT; n++) {
+            if (onlyFilters && n != onlyFilters) continue;
+            runMode(rig, n, modes[m], jerk, csv, results[m][n]);
+        }
+    }
+
+    if (csv) {
+        return 0;
+    }
+
+    printf("Filter-change latency (virtual time on the simulated mechanism, %s profile, %s steps)\n",
+           jerk > 0.0f ? "S-curve" : "trapezoidal", polled ? "polled" : "timer");
+    printf("%-8s %2s %5s | %7s %7s %7s | %4s %4s %4s | %6s %6s %6s | %6s %6s | %s\n",
+           "mode", "N", "moves", "vt50ms", "vt95ms", "vtmax", "it50", "it95", "itmx",
+           "err50", "err95", "errmx", "stp50", "stpmx", "fail");
+    for (int m = 0; m < 2; m++) {
+        for (uint8_t n = MIN_FILTER_COUNT; n <= MAX_FILTER_COUNT; n++) {
+            if (onlyFilters && n != onlyFilters) continue;
+            printSummary(modes[m] ? "encoder" : "steps", n, results[m][n]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,230 @@
+/**
+ * Two-wheel concurrency benchmark
+ *
+ * A 7-slot filter wheel and a 5-slot ND wheel on one board, both changed
+ * at every step of a sequence. Compares moving them one after the other
+ * (what blocking per-motor moves amount to), moving them together with
+ * steps polled from the 1 ms main loop, and moving them together with the
+ * steps of both merged onto one timer by the StepScheduler. Concurrent
+ * moves should take max(t1, t2) instead of t1 + t2; t1 and t2 are the solo
+ * move times of each wheel. Times are mechanism (virtual) time.
+ *
+ * --microsteps drives both mechanisms with N step pulses per full step, as
+ * a TMC driver does.
+ *
+ * Usage: program [--csv] [--steps N] [--microsteps N]
+ */
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "core/Clock.h"
+#include "core/MultiWheelController.h"
+#include "simulation/FilterWheelSimulator.h"
+#include "simulation/SimulatedMotorDriver.h"
+#include "simulation/SimulatedEncoder.h"
+#include "simulation/SimulatedStepTimer.h"
+#include "Stats.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+
+namespace {
+
+const uint8_t FILTERS[2] = {7, 5};
+
+enum class Mode { SEQUENTIAL, POLLED, SCHEDULED };
+
+const char* modeName(Mode mode) {
+    switch (mode) {
+        case Mode::SEQUENTIAL: return "sequential";
+        case Mode::POLLED:     return "polled";
+        case Mode::SCHEDULED:  return "scheduled";
+    }
+    return "?";
+}
+
+struct StepResult {
+    unsigned long wheelMs[2] = {0, 0};  // Move time of each wheel
+    unsigned long totalMs = 0;          // Until both wheels are in place
+    float errorDeg[2] = {0.0f, 0.0f};
+    bool ok = true;
+};
+
+/**
+ * Two simulated wheels behind a MultiWheelController on virtual time
+ */
+class DualRig {
+public:
+    SimulatedClock clock;
+    FilterWheelSimulator simulators[2];
+    std::unique_ptr<MultiWheelController> wheels;
+
+    explicit DualRig(const SimulatorConfig& config)
+        : simulators{FilterWheelSimulator(config), FilterWheelSimulator(withSeed(config, config.seed + 1))}
+    {
+        Clock::install(&clock);
+        Serial.setStdinEnabled(false);
+        Serial.setCapture(&serialSink, false);
+    }
+
+    ~DualRig() {
+        wheels.reset();
+        Serial.setCapture(nullptr);
+        Clock::install(nullptr);
+    }
+
+    bool start(bool scheduled) {
+        wheels.reset();
+        EEPROM.clear();
+        wheels.reset(new MultiWheelController());
+        if (scheduled) {
+            wheels->setStepTimer(std::unique_ptr<StepTimer>(new SimulatedStepTimer(&clock)));
+        }
+
+        for (uint8_t i = 0; i < 2; i++) {
+            simulators[i].reset();
+            std::unique_ptr<MotorDriver> driver(new SimulatedMotorDriver(simulators[i]));
+            driver->init();
+            if (!wheels->addWheel(std::move(driver),
+                                  std::unique_ptr<EncoderInterface>(new SimulatedEncoder(simulators[i])))) {
+                return false;
+            }
+            wheel(i).setFilterCount(FILTERS[i]);
+            wheel(i).setCurrentPosition(1);
+        }
+        serialSink.clear();
+        return true;
+    }
+
+    FilterWheelController& wheel(uint8_t i) { return *wheels->getWheel(i + 1); }
+
+    void waitForIdle() {
+        // Same cadence as the firmware loop()
+        while (wheel(0).isMotorMoving() || wheel(1).isMotorMoving()) {
+            wheels->update();
+            clock.delay(1);
+        }
+    }
+
+    float wheelErrorTo(uint8_t i, uint8_t position) {
+        float error = wheel(i).positionToAngle(position) - simulators[i].getWheelAngle();
+        while (error > 180.0f) error -= 360.0f;
+        while (error < -180.0f) error += 360.0f;
+        return error;
+    }
+
+private:
+    std::string serialSink;
+
+    static SimulatorConfig withSeed(SimulatorConfig config, uint32_t seed) {
+        config.seed = seed;
+        return config;
+    }
+};
+
+StepResult runStep(DualRig& rig, Mode mode, const uint8_t targets[2]) {
+    StepResult result;
+    unsigned long startMs = rig.clock.millis();
+
+    for (uint8_t i = 0; i < 2; i++) {
+        FilterWheelController& wheel = rig.wheel(i);
+        if (wheel.getCurrentPosition() == targets[i]) continue;
+        if (!wheel.moveToPosition(targets[i])) {
+            result.ok = false;
+        }
+        if (mode == Mode::SEQUENTIAL) {
+            rig.waitForIdle();
+        }
+    }
+    rig.waitForIdle();
+    result.totalMs = rig.clock.millis() - startMs;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        FilterWheelController& wheel = rig.wheel(i);
+        const FilterWheelController::MoveStats& stats = wheel.getLastMoveStats();
+        if (stats.toPosition == targets[i] && wheel.getCurrentPosition() == targets[i]) {
+            result.wheelMs[i] = stats.durationMs;
+            result.ok = result.ok && stats.success;
+        }
+        result.errorDeg[i] = rig.wheelErrorTo(i, targets[i]);
+        wheel.clearError();
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool csv = false;
+    int steps = 12;
+    SimulatorConfig config;
+    config.encoderOffsetDegrees = 0.0f;  // Wheels mounted as calibrated
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+            steps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--microsteps") == 0 && i + 1 < argc) {
+            config.microsteps = (uint16_t)atoi(argv[++i]);
+        }
+    }
+
+    DualRig rig(config);
+    const Mode modes[] = {Mode::SEQUENTIAL, Mode::POLLED, Mode::SCHEDULED};
+
+    if (csv) {
+        printf("mode,step,to1,to2,t1_ms,t2_ms,total_ms,err1_deg,err2_deg,ok\n");
+    } else {
+        printf("Two wheels (%u + %u slots) changed together, %u steps/rev x%u "
+               "(simulated mechanism time)\n", FILTERS[0], FILTERS[1],
+               config.stepsPerRevolution, config.microsteps);
+        printf("%-10s | %8s %8s | %8s %8s | %9s | %7s %7s | %s\n", "mode", "total_ms",
+               "t1+t2", "max_t", "over_ms", "steps_irq", "err1mx", "err2mx", "fail");
+    }
+
+    for (Mode mode : modes) {
+        if (!rig.start(mode != Mode::POLLED)) {
+            fprintf(stderr, "Failed to start the wheels\n");
+            return 1;
+        }
+
+        Stats totalMs;
+        Stats sumMs;
+        Stats maxMs;
+        Stats error[2];
+        int failures = 0;
+        for (int s = 1; s <= steps; s++) {
+            // Different strides, so both wheels move every step by varying amounts
+            const uint8_t targets[2] = {(uint8_t)(1 + (s * 3) % FILTERS[0]),
+                                        (uint8_t)(1 + (s * 2) % FILTERS[1])};
+            StepResult r = runStep(rig, mode, targets);
+            totalMs.add(r.totalMs);
+            sumMs.add(r.wheelMs[0] + r.wheelMs[1]);
+            maxMs.add(r.wheelMs[0] > r.wheelMs[1] ? r.wheelMs[0] : r.wheelMs[1]);
+            error[0].add(fabsf(r.errorDeg[0]));
+            error[1].add(fabsf(r.errorDeg[1]));
+            if (!r.ok) failures++;
+
+            if (csv) {
+                printf("%s,%d,%u,%u,%lu,%lu,%lu,%.3f,%.3f,%d\n", modeName(mode), s,
+                       targets[0], targets[1], r.wheelMs[0], r.wheelMs[1], r.totalMs,
+                       r.errorDeg[0], r.errorDeg[1], r.ok ? 1 : 0);
+            }
+        }
+
+        if (!csv) {
+            printf("%-10s | %8.0f %8.0f | %8.0f %8.0f | %9u | %7.2f %7.2f | %d\n", modeName(mode),
+                   totalMs.total(), sumMs.total(), maxMs.total(), totalMs.total() - maxMs.total(),
+                   rig.wheels->getStepScheduler().getDispatchCount(),
+                   error[0].max(), error[1].max(), failures);
+        }
+    }
+
+    if (!csv) {
+        printf("\nt1+t2 and max_t sum the per-wheel move times of each step; over_ms is the "
+               "total beyond max_t, steps_irq the steps issued by the shared timer\n");
+    }
+    return 0;
+}
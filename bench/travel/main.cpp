@@ -0,0 +1,148 @@
+/**
+ * Step-based fallback travel benchmark
+ *
+ * Runs typical imaging filter sequences on a 5-slot LRGBHa wheel without
+ * the encoder and compares forward-only moves with shortest-path moves
+ * (backlash compensated), with the nominal steps per revolution and with
+ * the step table learned by a revolution calibration beforehand. Reports
+ * total motor travel, mechanism time and the worst true wheel error seen
+ * after a move.
+ *
+ * Usage: program [--csv] [--spr N]   (N = true wheel steps per revolution)
+ */
+
+#include "SimulatedRig.h"
+#include "Stats.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+namespace {
+
+// Positions on the wheel: 1=L 2=R 3=G 4=B 5=Ha
+const char* const FILTER_NAMES[] = {"", "L", "R", "G", "B", "Ha"};
+
+struct Sequence {
+    const char* name;
+    const uint8_t* positions;
+    size_t length;
+};
+
+// Filter cycling during an LRGB + Ha night, returning to L each round
+const uint8_t CYCLE[] = {1, 2, 3, 4, 5, 1, 2, 3, 4, 5, 1, 2, 3, 4, 5, 1};
+
+// Refocus on L before every colour filter
+const uint8_t REFOCUS[] = {1, 2, 1, 3, 1, 4, 1, 5, 1, 2, 1, 3, 1, 4, 1, 5, 1};
+
+// Narrowband target with RGB star colour at the end of the night
+const uint8_t NARROWBAND[] = {5, 1, 5, 1, 5, 2, 3, 4, 1};
+
+const Sequence SEQUENCES[] = {
+    {"cycle", CYCLE, sizeof(CYCLE)},
+    {"refocus", REFOCUS, sizeof(REFOCUS)},
+    {"narrowband", NARROWBAND, sizeof(NARROWBAND)},
+};
+
+enum class Mode { FORWARD, SHORTEST, LEARNED };
+
+const char* modeName(Mode mode) {
+    switch (mode) {
+        case Mode::FORWARD:  return "forward";
+        case Mode::SHORTEST: return "shortest";
+        case Mode::LEARNED:  return "learned";
+    }
+    return "?";
+}
+
+struct Totals {
+    long steps = 0;
+    unsigned long timeMs = 0;
+    float maxError = 0.0f;
+    int failures = 0;
+};
+
+Totals runSequence(SimulatedRig& rig, const Sequence& sequence, Mode mode, bool csv) {
+    Totals totals;
+    rig.start(5, mode == Mode::LEARNED);
+    FilterWheelController& controller = *rig.controller;
+
+    if (mode == Mode::LEARNED) {
+        // Learn the table with the encoder, then run without it
+        controller.startRevolutionCalibration();
+        rig.waitForIdle();
+        rig.encoder->setAvailable(false);
+        controller.clearError();
+    }
+
+    controller.setShortestPathEnabled(mode != Mode::FORWARD);
+    controller.setBacklashSteps((int)rig.simulator.getConfig().backlashSteps);
+
+    for (size_t i = 0; i < sequence.length; i++) {
+        uint8_t from = controller.getCurrentPosition();
+        uint8_t to = sequence.positions[i];
+        if (from == to) continue;
+
+        bool ok = rig.moveAndWait(to);
+        const FilterWheelController::MoveStats& stats = controller.getLastMoveStats();
+        float error = rig.wheelErrorTo(to);
+
+        totals.steps += stats.stepsIssued;
+        totals.timeMs += stats.durationMs;
+        if (fabsf(error) > totals.maxError) totals.maxError = fabsf(error);
+        if (!ok) totals.failures++;
+
+        if (csv) {
+            printf("%s,%s,%s,%s,%ld,%lu,%.3f,%d\n", sequence.name,
+                   modeName(mode), FILTER_NAMES[from], FILTER_NAMES[to],
+                   stats.stepsIssued, stats.durationMs, error, ok ? 1 : 0);
+        }
+    }
+    rig.takeSerialOutput();
+    return totals;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool csv = false;
+    SimulatorConfig config;
+    config.encoderOffsetDegrees = 0.0f;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (strcmp(argv[i], "--spr") == 0 && i + 1 < argc) {
+            config.stepsPerRevolution = (uint16_t)atoi(argv[++i]);
+        }
+    }
+    SimulatedRig rig(config);
+
+    if (csv) {
+        printf("sequence,mode,from,to,steps,time_ms,error_deg,ok\n");
+    } else {
+        printf("Step-based fallback travel, 5-slot LRGBHa wheel, %u steps/rev (simulated mechanism time)\n",
+               config.stepsPerRevolution);
+        printf("%-11s %-9s | %7s %8s %8s | %6s | %s\n",
+               "sequence", "mode", "steps", "revs", "time_s", "errmx", "fail");
+    }
+
+    for (const Sequence& sequence : SEQUENCES) {
+        Totals forward = runSequence(rig, sequence, Mode::FORWARD, csv);
+        Totals shortest = runSequence(rig, sequence, Mode::SHORTEST, csv);
+        Totals learned = runSequence(rig, sequence, Mode::LEARNED, csv);
+        if (csv) continue;
+
+        int stepsPerRev = config.stepsPerRevolution;
+        const Totals* rows[] = {&forward, &shortest, &learned};
+        const Mode modes[] = {Mode::FORWARD, Mode::SHORTEST, Mode::LEARNED};
+        for (int m = 0; m < 3; m++) {
+            const Totals& t = *rows[m];
+            printf("%-11s %-9s | %7ld %8.2f %8.1f | %6.2f | %d\n",
+                   sequence.name, modeName(modes[m]),
+                   t.steps, (double)t.steps / stepsPerRev, t.timeMs / 1000.0, t.maxError, t.failures);
+        }
+        printf("%-11s %-9s | %6.0f%% less travel, %.0f%% less time\n", "", "",
+               100.0 * (forward.steps - shortest.steps) / forward.steps,
+               100.0 * ((double)forward.timeMs - shortest.timeMs) / forward.timeMs);
+    }
+    return 0;
+}
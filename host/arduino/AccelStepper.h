@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Host port of AccelStepper (Mike McCauley, GPL v3)
+ * Keeps the library's acceleration algorithm (David Austin's step timing)
+ * and pin sequences so step timing matches the target; pins only drive
+ * the recorded GPIO levels of the shim.
+ */
+class AccelStepper {
+public:
+    typedef enum {
+        FUNCTION  = 0,
+        DRIVER    = 1,
+        FULL2WIRE = 2,
+        FULL3WIRE = 3,
+        FULL4WIRE = 4,
+        HALF3WIRE = 6,
+        HALF4WIRE = 8
+    } MotorInterfaceType;
+
+    AccelStepper(uint8_t interface = AccelStepper::FULL4WIRE, uint8_t pin1 = 2, uint8_t pin2 = 3,
+                 uint8_t pin3 = 4, uint8_t pin4 = 5, bool enable = true);
+
+    void moveTo(long absolute);
+    void move(long relative);
+    bool run();
+    bool runSpeed();
+    void setMaxSpeed(float speed);
+    float maxSpeed();
+    void setAcceleration(float acceleration);
+    float acceleration();
+    void setSpeed(float speed);
+    float speed();
+    long distanceToGo();
+    long targetPosition();
+    long currentPosition();
+    void setCurrentPosition(long position);
+    void runToPosition();
+    bool runSpeedToPosition();
+    void runToNewPosition(long position);
+    void stop();
+    void disableOutputs();
+    void enableOutputs();
+    void setMinPulseWidth(unsigned int minWidth);
+    void setEnablePin(uint8_t enablePin = 0xff);
+    void setPinsInverted(bool directionInvert = false, bool stepInvert = false, bool enableInvert = false);
+    void setPinsInverted(bool pin1Invert, bool pin2Invert, bool pin3Invert, bool pin4Invert, bool enableInvert);
+    bool isRunning();
+
+    virtual ~AccelStepper() {}
+
+protected:
+    typedef enum {
+        DIRECTION_CCW = 0,
+        DIRECTION_CW  = 1
+    } Direction;
+
+    void computeNewSpeed();
+    virtual void setOutputPins(uint8_t mask);
+    virtual void step(long step);
+    void step1(long step);
+    void step2(long step);
+    void step4(long step);
+    void step8(long step);
+
+    bool _direction;
+
+private:
+    uint8_t _interface;
+    uint8_t _pin[4];
+    uint8_t _pinInverted[4];
+    long _currentPos;
+    long _targetPos;
+    float _speed;
+    float _maxSpeed;
+    float _acceleration;
+    float _sqrt_twoa;
+    unsigned long _stepInterval;
+    unsigned long _lastStepTime;
+    unsigned int _minPulseWidth;
+    bool _enableInverted;
+    uint8_t _enablePin;
+    long _n;
+    float _c0;
+    float _cn;
+    float _cmin;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Arduino.h"
+
+/**
+ * Headless stand-in for Adafruit_GFX
+ * Tracks cursor/text state so display code runs unchanged; nothing is drawn.
+ */
+class Adafruit_GFX : public Print {
+protected:
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x;
+    int16_t cursor_y;
+    uint8_t textsize;
+    uint16_t textcolor;
+    uint8_t rotation;
+    bool wrap;
+
+public:
+    Adafruit_GFX(int16_t w, int16_t h)
+        : _width(w), _height(h), cursor_x(0), cursor_y(0), textsize(1),
+          textcolor(1), rotation(0), wrap(true) {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    void setTextSize(uint8_t s) { textsize = s > 0 ? s : 1; }
+    void setTextColor(uint16_t c) { textcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { (void)bg; textcolor = c; }
+    void setTextWrap(bool w) { wrap = w; }
+    void setRotation(uint8_t r) { rotation = r & 3; }
+    uint8_t getRotation() const { return rotation; }
+    int16_t width() const { return (rotation & 1) ? _height : _width; }
+    int16_t height() const { return (rotation & 1) ? _width : _height; }
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+
+    size_t write(uint8_t c) override {
+        if (c == '\n') {
+            cursor_x = 0;
+            cursor_y += textsize * 8;
+        } else if (c != '\r') {
+            cursor_x += textsize * 6;
+        }
+        return 1;
+    }
+    using Print::write;
+};
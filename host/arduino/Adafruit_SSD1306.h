@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Adafruit_GFX.h"
+#include "Wire.h"
+#include <vector>
+
+#define SSD1306_BLACK 0
+#define SSD1306_WHITE 1
+#define SSD1306_INVERSE 2
+#define SSD1306_SWITCHCAPVCC 0x02
+#define SSD1306_EXTERNALVCC 0x01
+
+/**
+ * Headless SSD1306: keeps a framebuffer, display() is a no-op
+ */
+class Adafruit_SSD1306 : public Adafruit_GFX {
+private:
+    std::vector<uint8_t> buffer;
+
+public:
+    Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi = &Wire, int8_t rst_pin = -1)
+        : Adafruit_GFX(w, h), buffer((size_t)w * ((h + 7) / 8), 0) {
+        (void)twi;
+        (void)rst_pin;
+    }
+
+    bool begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC, uint8_t i2caddr = 0, bool reset = true) {
+        (void)switchvcc;
+        (void)i2caddr;
+        (void)reset;
+        return true;
+    }
+
+    void display() {}
+    void clearDisplay() { std::fill(buffer.begin(), buffer.end(), 0); }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+        uint8_t& cell = buffer[x + (y / 8) * _width];
+        uint8_t bit = 1 << (y & 7);
+        switch (color) {
+            case SSD1306_WHITE:   cell |= bit;  break;
+            case SSD1306_BLACK:   cell &= ~bit; break;
+            case SSD1306_INVERSE: cell ^= bit;  break;
+        }
+    }
+
+    uint8_t* getBuffer() { return buffer.data(); }
+};
@@ -0,0 +1,69 @@
+#include "Arduino.h"
+#include "ArduinoHost.h"
+#include <chrono>
+#include <thread>
+
+namespace {
+
+const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+uint8_t pinLevels[256] = {0};
+
+arduino_host::TimeSource* timeSource = nullptr;
+
+uint64_t elapsedMicros() {
+    if (timeSource) {
+        return timeSource->micros();
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+}
+
+} // namespace
+
+void arduino_host::setTimeSource(TimeSource* source) {
+    timeSource = source;
+}
+
+unsigned long millis() {
+    return (unsigned long)(elapsedMicros() / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)elapsedMicros();
+}
+
+void delay(uint32_t ms) {
+    if (timeSource) {
+        timeSource->sleepMicros(ms * 1000);
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    if (timeSource) {
+        timeSource->sleepMicros(us);
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    if (timeSource) {
+        timeSource->sleepMicros(arduino_host::YIELD_MICROS);
+    }
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    pinLevels[pin] = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    return pinLevels[pin];
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+/**
+ * Host (x86 Linux) Arduino shim
+ * Provides the subset of the Arduino core used by the firmware so that
+ * src/ can be compiled and profiled natively. Only built by [env:native].
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+#include "WString.h"
+#include "HardwareSerial.h"
+
+using std::abs;
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define F(string_literal) (string_literal)
+
+// ============================================
+// TIME
+// ============================================
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// ============================================
+// GPIO (levels are recorded, no hardware behind them)
+// ============================================
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+// ============================================
+// CHARACTER HELPERS
+// ============================================
+
+inline bool isAlphaNumeric(int c) { return isalnum(c) != 0; }
+inline bool isAlpha(int c) { return isalpha(c) != 0; }
+inline bool isDigit(int c) { return isdigit(c) != 0; }
+inline bool isSpace(int c) { return isspace(c) != 0; }
+
+// ============================================
+// SKETCH ENTRY POINTS (see main.cpp)
+// ============================================
+
+void setup();
+void loop();
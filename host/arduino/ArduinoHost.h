@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Host-only extensions of the Arduino shim
+ */
+namespace arduino_host {
+
+/**
+ * Replacement time base for millis()/micros()/delay()/yield()
+ */
+class TimeSource {
+public:
+    virtual ~TimeSource() = default;
+    virtual uint64_t micros() = 0;
+    virtual void sleepMicros(uint32_t us) = 0;
+};
+
+/**
+ * Install a time source (nullptr restores the wall clock)
+ * With a virtual source, yield() advances time by YIELD_MICROS so that
+ * polling loops such as AccelStepper::runToPosition() make progress.
+ */
+void setTimeSource(TimeSource* source);
+
+constexpr uint32_t YIELD_MICROS = 10;
+
+} // namespace arduino_host
@@ -0,0 +1,34 @@
+#include "EEPROM.h"
+
+EEPROMClass EEPROM;
+
+EEPROMClass::EEPROMClass() : size(0), commitCount(0) {
+    memset(data, 0xFF, sizeof(data));
+}
+
+bool EEPROMClass::begin(size_t requestedSize) {
+    if (requestedSize == 0 || requestedSize > MAX_SIZE) {
+        return false;
+    }
+    size = requestedSize;
+    return true;
+}
+
+bool EEPROMClass::commit() {
+    commitCount++;
+    return true;
+}
+
+uint8_t EEPROMClass::read(int address) {
+    if (address < 0 || (size_t)address >= size) return 0;
+    return data[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+    if (address < 0 || (size_t)address >= size) return;
+    data[address] = value;
+}
+
+void EEPROMClass::clear() {
+    memset(data, 0xFF, sizeof(data));
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * In-memory EEPROM emulation (same API as the ESP32 EEPROM library)
+ * Contents start erased (0xFF) and are lost when the process exits.
+ */
+class EEPROMClass {
+private:
+    static const size_t MAX_SIZE = 4096;
+
+    uint8_t data[MAX_SIZE];
+    size_t size;
+    uint32_t commitCount;
+
+public:
+    EEPROMClass();
+
+    bool begin(size_t requestedSize);
+    void end() {}
+    bool commit();
+
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    size_t length() const { return size; }
+
+    template<typename T>
+    T& get(int address, T& value) {
+        if (address >= 0 && (size_t)address + sizeof(T) <= size) {
+            memcpy(&value, &data[address], sizeof(T));
+        }
+        return value;
+    }
+
+    template<typename T>
+    const T& put(int address, const T& value) {
+        if (address >= 0 && (size_t)address + sizeof(T) <= size) {
+            memcpy(&data[address], &value, sizeof(T));
+        }
+        return value;
+    }
+
+    // Host-only helpers
+    void clear();
+    uint32_t getCommitCount() const { return commitCount; }
+};
+
+extern EEPROMClass EEPROM;
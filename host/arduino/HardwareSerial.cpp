@@ -0,0 +1,129 @@
+#include "HardwareSerial.h"
+#include "WString.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+HardwareSerial Serial;
+
+// ============================================
+// PRINT
+// ============================================
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+size_t Print::write(const char* str) {
+    if (!str) return 0;
+    return write((const uint8_t*)str, strlen(str));
+}
+
+size_t Print::print(const String& s) { return write(s.c_str()); }
+size_t Print::print(const char* str) { return write(str); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char value, int base) { return print((unsigned long)value, base); }
+size_t Print::print(int value, int base) { return print((long)value, base); }
+size_t Print::print(unsigned int value, int base) { return print((unsigned long)value, base); }
+size_t Print::print(long value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(unsigned long value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(double value, int digits) { return print(String(value, (unsigned char)digits)); }
+
+size_t Print::println() { return write("\r\n"); }
+size_t Print::println(const String& s) { return print(s) + println(); }
+size_t Print::println(const char* str) { return print(str) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(unsigned char value, int base) { return print(value, base) + println(); }
+size_t Print::println(int value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned int value, int base) { return print(value, base) + println(); }
+size_t Print::println(long value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned long value, int base) { return print(value, base) + println(); }
+size_t Print::println(double value, int digits) { return print(value, digits) + println(); }
+
+// ============================================
+// HARDWARE SERIAL
+// ============================================
+
+HardwareSerial::HardwareSerial()
+    : captureTarget(nullptr), echoToStdout(true), stdinEnabled(true), stdinConfigured(false) {
+}
+
+void HardwareSerial::begin(unsigned long baud) {
+    (void)baud;
+    if (stdinEnabled && !stdinConfigured) {
+        int flags = fcntl(STDIN_FILENO, F_GETFL, 0);
+        if (flags >= 0) {
+            fcntl(STDIN_FILENO, F_SETFL, flags | O_NONBLOCK);
+        }
+        stdinConfigured = true;
+    }
+}
+
+void HardwareSerial::pollStdin() {
+    if (!stdinEnabled || !stdinConfigured) return;
+
+    char buf[256];
+    ssize_t n = ::read(STDIN_FILENO, buf, sizeof(buf));
+    if (n > 0) {
+        rxBuffer.append(buf, (size_t)n);
+    }
+}
+
+int HardwareSerial::available() {
+    if (rxBuffer.empty()) {
+        pollStdin();
+    }
+    return (int)rxBuffer.size();
+}
+
+int HardwareSerial::read() {
+    if (available() <= 0) return -1;
+    int c = (uint8_t)rxBuffer[0];
+    rxBuffer.erase(0, 1);
+    return c;
+}
+
+int HardwareSerial::peek() {
+    if (available() <= 0) return -1;
+    return (uint8_t)rxBuffer[0];
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (captureTarget) {
+        captureTarget->push_back((char)c);
+    }
+    if (echoToStdout) {
+        fputc(c, stdout);
+        if (c == '\n') fflush(stdout);
+    }
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (captureTarget) {
+        captureTarget->append((const char*)buffer, size);
+    }
+    if (echoToStdout) {
+        fwrite(buffer, 1, size, stdout);
+        if (memchr(buffer, '\n', size)) fflush(stdout);
+    }
+    return size;
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+void HardwareSerial::injectInput(const std::string& data) {
+    rxBuffer += data;
+}
+
+void HardwareSerial::setCapture(std::string* target, bool echo) {
+    captureTarget = target;
+    echoToStdout = target ? echo : true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+class String;
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+/**
+ * Minimal Print base class (Arduino core compatible overload set)
+ */
+class Print {
+public:
+    virtual ~Print() = default;
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str);
+
+    size_t print(const String& s);
+    size_t print(const char* str);
+    size_t print(char c);
+    size_t print(unsigned char value, int base = DEC);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+
+    size_t println();
+    size_t println(const String& s);
+    size_t println(const char* str);
+    size_t println(char c);
+    size_t println(unsigned char value, int base = DEC);
+    size_t println(int value, int base = DEC);
+    size_t println(unsigned int value, int base = DEC);
+    size_t println(long value, int base = DEC);
+    size_t println(unsigned long value, int base = DEC);
+    size_t println(double value, int digits = 2);
+
+    virtual void flush() {}
+};
+
+/**
+ * Host serial port
+ * Output goes to stdout, input is read non-blocking from stdin.
+ * Tools and benchmarks can capture output and inject input instead.
+ */
+class HardwareSerial : public Print {
+private:
+    std::string rxBuffer;
+    std::string* captureTarget;
+    bool echoToStdout;
+    bool stdinEnabled;
+    bool stdinConfigured;
+
+    void pollStdin();
+
+public:
+    HardwareSerial();
+
+    void begin(unsigned long baud);
+    void end() {}
+
+    int available();
+    int read();
+    int peek();
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    void flush() override;
+
+    operator bool() const { return true; }
+
+    // Host-only helpers
+    void injectInput(const std::string& data);
+    void setCapture(std::string* target, bool echo = false);
+    void setStdinEnabled(bool enabled) { stdinEnabled = enabled; }
+};
+
+extern HardwareSerial Serial;
@@ -0,0 +1,10 @@
+#pragma once
+
+// Host builds have no SPI bus; header exists so driver sources include cleanly.
+class SPIClass {
+public:
+    void begin() {}
+    void end() {}
+};
+
+inline SPIClass SPI;
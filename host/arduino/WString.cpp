@@ -0,0 +1,220 @@
+#include "WString.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+
+namespace {
+
+std::string formatInteger(unsigned long long magnitude, bool negative, unsigned char base) {
+    if (base < 2 || base > 36) {
+        base = 10;
+    }
+
+    char digits[72];
+    int pos = 0;
+    do {
+        unsigned digit = magnitude % base;
+        digits[pos++] = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        magnitude /= base;
+    } while (magnitude > 0);
+
+    std::string out;
+    if (negative) {
+        out += '-';
+    }
+    while (pos > 0) {
+        out += digits[--pos];
+    }
+    return out;
+}
+
+std::string formatSigned(long long value, unsigned char base) {
+    if (base == 10 && value < 0) {
+        return formatInteger((unsigned long long)(-(value + 1)) + 1, true, base);
+    }
+    return formatInteger((unsigned long long)value, false, base);
+}
+
+std::string formatFloat(double value, unsigned char decimalPlaces) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+    return std::string(buf);
+}
+
+} // namespace
+
+String::String(const char* cstr) : buffer(cstr ? cstr : "") {}
+String::String(const std::string& str) : buffer(str) {}
+String::String(char c) : buffer(1, c) {}
+String::String(unsigned char value, unsigned char base) : buffer(formatInteger(value, false, base)) {}
+String::String(int value, unsigned char base) : buffer(formatSigned(value, base)) {}
+String::String(unsigned int value, unsigned char base) : buffer(formatInteger(value, false, base)) {}
+String::String(long value, unsigned char base) : buffer(formatSigned(value, base)) {}
+String::String(unsigned long value, unsigned char base) : buffer(formatInteger(value, false, base)) {}
+String::String(float value, unsigned char decimalPlaces) : buffer(formatFloat(value, decimalPlaces)) {}
+String::String(double value, unsigned char decimalPlaces) : buffer(formatFloat(value, decimalPlaces)) {}
+
+String& String::operator=(const char* cstr) {
+    buffer = cstr ? cstr : "";
+    return *this;
+}
+
+bool String::concat(const String& str) {
+    buffer += str.buffer;
+    return true;
+}
+
+bool String::concat(const char* cstr) {
+    if (!cstr) return false;
+    buffer += cstr;
+    return true;
+}
+
+bool String::concat(char c) {
+    buffer += c;
+    return true;
+}
+
+bool String::equalsIgnoreCase(const String& s) const {
+    if (buffer.length() != s.buffer.length()) return false;
+    for (size_t i = 0; i < buffer.length(); i++) {
+        if (tolower((unsigned char)buffer[i]) != tolower((unsigned char)s.buffer[i])) return false;
+    }
+    return true;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return startsWith(prefix, 0);
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+    if (offset > buffer.length() || prefix.buffer.length() > buffer.length() - offset) return false;
+    return buffer.compare(offset, prefix.buffer.length(), prefix.buffer) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    if (suffix.buffer.length() > buffer.length()) return false;
+    return buffer.compare(buffer.length() - suffix.buffer.length(), suffix.buffer.length(), suffix.buffer) == 0;
+}
+
+char String::charAt(unsigned int index) const {
+    return index < buffer.length() ? buffer[index] : 0;
+}
+
+void String::setCharAt(unsigned int index, char c) {
+    if (index < buffer.length()) buffer[index] = c;
+}
+
+char& String::operator[](unsigned int index) {
+    static char dummy;
+    if (index >= buffer.length()) {
+        dummy = 0;
+        return dummy;
+    }
+    return buffer[index];
+}
+
+int String::indexOf(char ch) const {
+    return indexOf(ch, 0);
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+    size_t pos = buffer.find(ch, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& str) const {
+    return indexOf(str, 0);
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+    size_t pos = buffer.find(str.buffer, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char ch) const {
+    size_t pos = buffer.rfind(ch);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int beginIndex) const {
+    return substring(beginIndex, length());
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    // Arduino swaps reversed bounds and clamps to the string length
+    if (beginIndex > endIndex) std::swap(beginIndex, endIndex);
+    if (beginIndex >= buffer.length()) return String();
+    if (endIndex > buffer.length()) endIndex = length();
+    return String(buffer.substr(beginIndex, endIndex - beginIndex));
+}
+
+void String::replace(const String& find, const String& replaceWith) {
+    if (find.buffer.empty()) return;
+    size_t pos = 0;
+    while ((pos = buffer.find(find.buffer, pos)) != std::string::npos) {
+        buffer.replace(pos, find.buffer.length(), replaceWith.buffer);
+        pos += replaceWith.buffer.length();
+    }
+}
+
+void String::remove(unsigned int index) {
+    if (index < buffer.length()) buffer.erase(index);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index < buffer.length()) buffer.erase(index, count);
+}
+
+void String::toUpperCase() {
+    for (auto& c : buffer) c = (char)toupper((unsigned char)c);
+}
+
+void String::toLowerCase() {
+    for (auto& c : buffer) c = (char)tolower((unsigned char)c);
+}
+
+void String::trim() {
+    size_t begin = 0;
+    while (begin < buffer.length() && isspace((unsigned char)buffer[begin])) begin++;
+    size_t end = buffer.length();
+    while (end > begin && isspace((unsigned char)buffer[end - 1])) end--;
+    buffer = buffer.substr(begin, end - begin);
+}
+
+long String::toInt() const {
+    return atol(buffer.c_str());
+}
+
+float String::toFloat() const {
+    return (float)atof(buffer.c_str());
+}
+
+double String::toDouble() const {
+    return atof(buffer.c_str());
+}
+
+String operator+(const String& lhs, const String& rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
+
+String operator+(const String& lhs, const char* rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
+
+String operator+(const char* lhs, const String& rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
+
+String operator+(const String& lhs, char rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
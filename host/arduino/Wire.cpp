@@ -0,0 +1,107 @@
+#include "Wire.h"
+
+TwoWire Wire;
+
+TwoWire::TwoWire()
+    : deviceCount(0), txAddress(0), txLength(0), rxLength(0), rxIndex(0) {
+}
+
+bool TwoWire::begin() {
+    return true;
+}
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+    (void)sda;
+    (void)scl;
+    (void)frequency;
+    return true;
+}
+
+TwoWireDevice* TwoWire::findDevice(uint8_t address) const {
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        if (devices[i].address == address) {
+            return devices[i].device;
+        }
+    }
+    return nullptr;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+    txAddress = address;
+    txLength = 0;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    (void)sendStop;
+    TwoWireDevice* device = findDevice(txAddress);
+    if (!device) {
+        return 2;  // Address NACK, same code as the Arduino core
+    }
+    device->onReceive(txBuffer, txLength);
+    txLength = 0;
+    return 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (txLength >= BUFFER_SIZE) return 0;
+    txBuffer[txLength++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t length) {
+    size_t n = 0;
+    while (n < length && write(data[n])) {
+        n++;
+    }
+    return n;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool sendStop) {
+    (void)sendStop;
+    rxIndex = 0;
+    rxLength = 0;
+
+    TwoWireDevice* device = findDevice(address);
+    if (!device) {
+        return 0;
+    }
+
+    size_t wanted = quantity < BUFFER_SIZE ? quantity : BUFFER_SIZE;
+    rxLength = device->onRequest(rxBuffer, wanted);
+    return (uint8_t)rxLength;
+}
+
+int TwoWire::available() {
+    return (int)(rxLength - rxIndex);
+}
+
+int TwoWire::read() {
+    if (rxIndex >= rxLength) return -1;
+    return rxBuffer[rxIndex++];
+}
+
+int TwoWire::peek() {
+    if (rxIndex >= rxLength) return -1;
+    return rxBuffer[rxIndex];
+}
+
+bool TwoWire::attachDevice(uint8_t address, TwoWireDevice* device) {
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        if (devices[i].address == address) {
+            devices[i].device = device;
+            return true;
+        }
+    }
+    if (deviceCount >= MAX_DEVICES) return false;
+    devices[deviceCount++] = {address, device};
+    return true;
+}
+
+void TwoWire::detachDevice(uint8_t address) {
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        if (devices[i].address == address) {
+            devices[i] = devices[--deviceCount];
+            return;
+        }
+    }
+}
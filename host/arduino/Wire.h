@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Host-side I2C target
+ * Register an implementation with TwoWire::attachDevice() to emulate
+ * a peripheral; unattached addresses NACK like an empty bus.
+ */
+class TwoWireDevice {
+public:
+    virtual ~TwoWireDevice() = default;
+
+    // Bytes written by the controller in one transaction
+    virtual void onReceive(const uint8_t* data, size_t length) = 0;
+
+    // Fill up to length bytes for a read; returns number of bytes supplied
+    virtual size_t onRequest(uint8_t* buffer, size_t length) = 0;
+};
+
+class TwoWire {
+private:
+    static const size_t BUFFER_SIZE = 128;
+    static const uint8_t MAX_DEVICES = 8;
+
+    struct DeviceSlot {
+        uint8_t address;
+        TwoWireDevice* device;
+    };
+
+    DeviceSlot devices[MAX_DEVICES];
+    uint8_t deviceCount;
+
+    uint8_t txAddress;
+    uint8_t txBuffer[BUFFER_SIZE];
+    size_t txLength;
+
+    uint8_t rxBuffer[BUFFER_SIZE];
+    size_t rxLength;
+    size_t rxIndex;
+
+    TwoWireDevice* findDevice(uint8_t address) const;
+
+public:
+    TwoWire();
+
+    bool begin();
+    bool begin(int sda, int scl, uint32_t frequency = 0);
+    void setClock(uint32_t frequency) { (void)frequency; }
+
+    void beginTransmission(uint8_t address);
+    uint8_t endTransmission(bool sendStop = true);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t* data, size_t length);
+
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+    int available();
+    int read();
+    int peek();
+
+    // Host-only helpers
+    bool attachDevice(uint8_t address, TwoWireDevice* device);
+    void detachDevice(uint8_t address);
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,11 @@
+#include "Arduino.h"
+
+// Same contract as the Arduino core: setup() once, then loop() forever.
+// Programs that need their own entry point (benchmarks) exclude this file.
+int main() {
+    setup();
+    for (;;) {
+        loop();
+    }
+    return 0;
+}
@@ -35,6 +35,16 @@ void CommandHandlers::registerAllCommands(CommandProcessor& processor) {
     processor.registerCommand("MP", "Move to position",
         [this](const String& cmd, String& response) { return handleMoveToPosition(cmd, response); });
 
+    // Move queue (position sequences executed back to back)
+    processor.registerCommand("MQ", "Queue positions with dwell times",
+        [this](const String& cmd, String& response) { return handleQueueMoves(cmd, response); });
+
+    processor.registerCommand("GQ", "Get move queue progress",
+        [this](const String& cmd, String& response) { return handleGetQueueStatus(cmd, response); });
+
+    processor.registerCommand("CQ", "Clear move queue",
+        [this](const String& cmd, String& response) { return handleClearQueue(cmd, response); });
+
     processor.registerCommand("SP", "Set current position",
         [this](const String& cmd, String& response) { return handleSetPosition(cmd, response); });
 
@@ -44,6 +54,9 @@ void CommandHandlers::registerAllCommands(CommandProcessor& processor) {
     processor.registerCommand("STATUS", "Get system status",
         [this](const String& cmd, String& response) { return handleGetStatus(cmd, response); });
 
+    processor.registerCommand("EVT", "Enable/disable move event lines",
+        [this](const String& cmd, String& response) { return handleSetEvents(cmd, response); });
+
     // System info commands
     processor.registerCommand("ID", "Get device ID",
         [this](const String& cmd, String& response) { return handleGetDeviceId(cmd, response); });
@@ -129,6 +142,46 @@ void CommandHandlers::registerAllCommands(CommandProcessor& processor) {
     processor.registerCommand("CALCFM", "Confirm guided calibration",
         [this](const String& cmd, String& response) { return handleConfirmGuidedCalibration(cmd, response); });
 
+    // Learned step table (steps per revolution + per-position steps)
+    processor.registerCommand("CALSTEPS", "Learn steps per revolution with the encoder",
+        [this](const String& cmd, String& response) { return handleCalibrateSteps(cmd, response); });
+
+    processor.registerCommand("GSTEPS", "Get step table",
+        [this](const String& cmd, String& response) { return handleGetStepTable(cmd, response); });
+
+    processor.registerCommand("CLEARSTEPS", "Clear learned step table",
+        [this](const String& cmd, String& response) { return handleClearStepTable(cmd, response); });
+
+    // Sensorless homing against a hard stop (no encoder needed)
+    processor.registerCommand("HOME", "Home against the hard stop with stall detection",
+        [this](const String& cmd, String& response) { return handleSensorlessHoming(cmd, response); });
+
+    // Backlash measurement and compensation
+    processor.registerCommand("CALBL", "Measure backlash with the encoder",
+        [this](const String& cmd, String& response) { return handleCalibrateBacklash(cmd, response); });
+
+    processor.registerCommand("GBL", "Get backlash configuration",
+        [this](const String& cmd, String& response) { return handleGetBacklash(cmd, response); });
+
+    processor.registerCommand("SBL", "Set backlash steps",
+        [this](const String& cmd, String& response) { return handleSetBacklash(cmd, response); });
+
+    processor.registerCommand("APPR", "Set final approach direction",
+        [this](const String& cmd, String& response) { return handleSetApproachDirection(cmd, response); });
+
+    // Angle PID gains (relay autotune or manual override)
+    processor.registerCommand("PIDTUNE", "Autotune angle PID gains with the encoder",
+        [this](const String& cmd, String& response) { return handlePidAutotune(cmd, response); });
+
+    processor.registerCommand("GPID", "Get angle PID gains",
+        [this](const String& cmd, String& response) { return handleGetPidGains(cmd, response); });
+
+    processor.registerCommand("SPID", "Set angle PID gains",
+        [this](const String& cmd, String& response) { return handleSetPidGains(cmd, response); });
+
+    processor.registerCommand("RPID", "Reset angle PID gains to defaults",
+        [this](const String& cmd, String& response) { return handleResetPidGains(cmd, response); });
+
     // Custom angle calibration commands
     processor.registerCommand("SETANG", "Set custom angle for position",
         [this](const String& cmd, String& response) { return handleSetCustomAngle(cmd, response); });
@@ -195,6 +248,86 @@ CommandResult CommandHandlers::handleMoveToPosition(const String& cmd, String& r
     }
 }
 
+CommandResult CommandHandlers::handleQueueMoves(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+    if (*isMoving) {
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+
+    // MQ[pos][:dwellMs],[pos][:dwellMs],...
+    uint8_t positions[FilterWheelController::MAX_QUEUED_MOVES];
+    uint32_t dwellMs[FilterWheelController::MAX_QUEUED_MOVES];
+    uint8_t count = 0;
+
+    int start = 2;
+    while (start < (int)cmd.length()) {
+        int end = cmd.indexOf(',', start);
+        if (end < 0) {
+            end = cmd.length();
+        }
+        if (count >= FilterWheelController::MAX_QUEUED_MOVES) {
+            response = "ERROR:Too many entries (max " + String(FilterWheelController::MAX_QUEUED_MOVES) + ")";
+            return CommandResult::ERROR_INVALID_PARAMETER;
+        }
+
+        String entry = cmd.substring(start, end);
+        int colonPos = entry.indexOf(':');
+        String positionStr = (colonPos < 0) ? entry : entry.substring(0, colonPos);
+        long dwell = (colonPos < 0) ? 0 : entry.substring(colonPos + 1).toInt();
+
+        int position = positionStr.toInt();
+        if (positionStr.length() == 0 || !isValidPosition(position) || dwell < 0) {
+            response = "ERROR:Invalid entry " + String(count + 1);
+            return CommandResult::ERROR_INVALID_PARAMETER;
+        }
+
+        positions[count] = (uint8_t)position;
+        dwellMs[count] = (uint32_t)dwell;
+        count++;
+        start = end + 1;
+    }
+
+    if (count == 0) {
+        response = "ERROR:Invalid format. Use MQ[pos][:dwellMs],...";
+        return CommandResult::ERROR_INVALID_FORMAT;
+    }
+    if (!controller->queueMoves(positions, dwellMs, count)) {
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+
+    response = "MQ:QUEUED=" + String(count);
+    return CommandResult::SUCCESS;
+}
+
+CommandResult CommandHandlers::handleGetQueueStatus(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+
+    FilterWheelController::QueueStatus status = controller->getQueueStatus();
+    response = "QUEUE:STATE=" + String(FilterWheelController::getQueueStateName(status.state));
+    response += ",DONE=" + String(status.completed);
+    response += ",TOTAL=" + String(status.total);
+    response += ",POS=" + String(status.position);
+    response += ",DWELL_LEFT=" + String(status.dwellRemainingMs);
+    return CommandResult::SUCCESS;
+}
+
+CommandResult CommandHandlers::handleClearQueue(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+
+    controller->clearMoveQueue();
+    response = "QUEUE:CLEARED";
+    return CommandResult::SUCCESS;
+}
+
 CommandResult CommandHandlers::handleSetPosition(const String& cmd, String& response) {
     int position;
     if (!parseIntParameter(cmd, "SP", position)) {
@@ -215,7 +348,10 @@ CommandResult CommandHandlers::handleSetPosition(const String& cmd, String& resp
 }
 
 CommandResult CommandHandlers::handleEmergencyStop(const String& cmd, String& response) {
-    if (motorDriver) {
+    if (controller) {
+        // Aborts the motion state machine as well as the driver
+        controller->emergencyStop();
+    } else if (motorDriver) {
         motorDriver->emergencyStop();
     }
     *isMoving = false;
@@ -223,13 +359,35 @@ CommandResult CommandHandlers::handleEmergencyStop(const String& cmd, String& re
     return CommandResult::SUCCESS;
 }
 
+CommandResult CommandHandlers::handleSetEvents(const String& cmd, String& response) {
+    if (!commandProcessor) {
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+
+    // EVT = query, EVT1 = on, EVT0 = off
+    if (cmd.length() > 3) {
+        int enabled = cmd.substring(3).toInt();
+        if (enabled != 0 && enabled != 1) {
+            return CommandResult::ERROR_INVALID_PARAMETER;
+        }
+        commandProcessor->setEventsEnabled(enabled == 1);
+    }
+
+    response = "EVENTS:" + String(commandProcessor->areEventsEnabled() ? "ON" : "OFF");
+    return CommandResult::SUCCESS;
+}
+
 CommandResult CommandHandlers::handleGetStatus(const String& cmd, String& response) {
     response = "STATUS:POS=" + String(*currentPosition);
     response += ",MOVING=" + String(*isMoving ? "YES" : "NO");
+    if (controller) {
+        response += ",STATE=" + String(controller->getMotionStateName());
+    }
     response += ",CAL=" + String(*isCalibrated ? "YES" : "NO");
 
     if (encoder && encoder->isAvailable()) {
-        response += ",ANGLE=" + String(encoder->getAngle(), 1);
+        float angle = controller ? controller->getEncoderAngle() : encoder->getAngle();
+        response += ",ANGLE=" + String(angle, 1);
     }
 
     response += ",ERROR=0";
@@ -392,9 +550,14 @@ CommandResult CommandHandlers::handleGetMotorConfig(const String& cmd, String& r
         response = "MOTOR_CONFIG:SPEED=" + String(motorDriver->getCurrentSpeed());
         response += ",MAX_SPEED=" + String(motorDriver->getMaxSpeed());
         response += ",ACCEL=" + String(motorDriver->getAcceleration());
-        response += ",DISABLE_DELAY=" + String(motorDriver->getDisableDelay());
-        response += ",STEPS_PER_REV=" + String(motorDriver->getStepsPerRevolution());
+        uint32_t disableDelay = controller ? controller->getMotorDisableDelay() : motorDriver->getDisableDelay();
+        response += ",DISABLE_DELAY=" + String(disableDelay);
+        long stepsPerRev = controller ? controller->getStepsPerRevolution() : motorDriver->getStepsPerRevolution();
+        response += ",STEPS_PER_REV=" + String(stepsPerRev);
         response += ",MOTOR_INV=" + String(motorDriver->isDirectionReversed() ? "1" : "0");
+        if (controller) {
+            response += ",POWER=" + String(FilterWheelController::getMotorPowerStateName(controller->getMotorPowerState()));
+        }
 
         // Add encoder inversion status if encoder is available
         if (encoder && encoder->isAvailable()) {
@@ -481,6 +644,9 @@ CommandResult CommandHandlers::handleSetMotorDisableDelay(const String& cmd, Str
 
     if (motorDriver) {
         motorDriver->setDisableDelay(delay);
+        if (controller) {
+            controller->setMotorDisableDelay(delay);
+        }
         if (configManager) {
             configManager->saveMotorDisableDelay(delay);
         }
@@ -523,12 +689,16 @@ CommandResult CommandHandlers::handleStepForward(const String& cmd, String& resp
     }
 
     if (motorDriver) {
-        // Enable motor first
-        motorDriver->enableMotor();
-        motorDriver->stepForward(steps);
-        // Activate movement flag so motor runs
-        if (isMoving) {
-            *isMoving = true;
+        // Same coil power states as a filter move
+        if (controller) {
+            controller->beginManualMove();
+        } else {
+            motorDriver->enableMotor();
+        }
+        // Full steps, so the distance does not depend on microstepping
+        motorDriver->stepForward((long)steps * motorDriver->getMicrosteps());  // Blocking, complete on return
+        if (controller) {
+            controller->endManualMove();
         }
     }
 
@@ -553,12 +723,16 @@ CommandResult CommandHandlers::handleStepBackward(const String& cmd, String& res
     }
 
     if (motorDriver) {
-        // Enable motor first
-        motorDriver->enableMotor();
-        motorDriver->stepBackward(steps);
-        // Activate movement flag so motor runs
-        if (isMoving) {
-            *isMoving = true;
+        // Same coil power states as a filter move
+        if (controller) {
+            controller->beginManualMove();
+        } else {
+            motorDriver->enableMotor();
+        }
+        // Full steps, so the distance does not depend on microstepping
+        motorDriver->stepBackward((long)steps * motorDriver->getMicrosteps());  // Blocking, complete on return
+        if (controller) {
+            controller->endManualMove();
         }
     }
 
@@ -567,7 +741,9 @@ CommandResult CommandHandlers::handleStepBackward(const String& cmd, String& res
 }
 
 CommandResult CommandHandlers::handleMotorEnable(const String& cmd, String& response) {
-    if (motorDriver) {
+    if (controller) {
+        controller->setMotorPower(true);
+    } else if (motorDriver) {
         motorDriver->enableMotor();
     }
 
@@ -576,7 +752,9 @@ CommandResult CommandHandlers::handleMotorEnable(const String& cmd, String& resp
 }
 
 CommandResult CommandHandlers::handleMotorDisable(const String& cmd, String& response) {
-    if (motorDriver) {
+    if (controller) {
+        controller->setMotorPower(false);
+    } else if (motorDriver) {
         motorDriver->disableMotor();
     }
 
@@ -654,10 +832,12 @@ CommandResult CommandHandlers::handleGetEncoderStatus(const String& cmd, String&
         return CommandResult::SUCCESS;
     }
 
-    float angle = encoder->getAngle();
-    uint16_t rawValue = encoder->getRawValue();
+    // Angle, raw value and magnet health from one sensor read
+    float angle;
+    uint16_t rawValue;
+    bool healthy;
+    encoder->readStatus(angle, rawValue, healthy);
     int8_t direction = encoder->getRotationDirection();
-    bool healthy = encoder->isHealthy();
     float offset = encoder->getAngleOffset();
 
     // Calculate expected angle for current position
@@ -764,6 +944,203 @@ CommandResult CommandHandlers::handleConfirmGuidedCalibration(const String& cmd,
     return CommandResult::SUCCESS;
 }
 
+CommandResult CommandHandlers::handleCalibrateSteps(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+    if (*isMoving) {
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+    if (!controller->startRevolutionCalibration()) {
+        response = "ERROR:Encoder not available";
+        return CommandResult::ERROR_ENCODER_UNAVAILABLE;
+    }
+
+    response = "CALSTEPS:STARTED";
+    return CommandResult::SUCCESS;
+}
+
+CommandResult CommandHandlers::handleGetStepTable(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+
+    response = "STEPS:REV=" + String(controller->getStepsPerRevolution());
+    response += ",SOURCE=" + String(controller->hasStepTable() ? "LEARNED" : "NOMINAL");
+    for (uint8_t i = 1; i <= *numFilters; i++) {
+        response += ",P" + String(i) + "=" + String(controller->getPositionSteps(i));
+    }
+    return CommandResult::SUCCESS;
+}
+
+CommandResult CommandHandlers::handleClearStepTable(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+
+    controller->clearStepTable();
+    response = "CLEARSTEPS:Step table cleared. Using nominal steps per revolution.";
+    return CommandResult::SUCCESS;
+}
+
+CommandResult CommandHandlers::handleSensorlessHoming(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+    if (*isMoving) {
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+    if (!controller->startSensorlessHoming()) {
+        response = "ERROR:Stall detection not available";
+        return CommandResult::ERROR_INVALID_PARAMETER;
+    }
+
+    response = "HOME:STARTED";
+    return CommandResult::SUCCESS;
+}
+
+CommandResult CommandHandlers::handleCalibrateBacklash(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+    if (*isMoving) {
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+    if (!controller->startBacklashCalibration()) {
+        response = "ERROR:Encoder not available";
+        return CommandResult::ERROR_ENCODER_UNAVAILABLE;
+    }
+
+    response = "CALBL:STARTED";
+    return CommandResult::SUCCESS;
+}
+
+CommandResult CommandHandlers::handleGetBacklash(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+
+    response = "BACKLASH:STEPS=" + String(controller->getBacklashSteps());
+    response += ",APPROACH=" + String((int)controller->getApproachDirection());
+    return CommandResult::SUCCESS;
+}
+
+CommandResult CommandHandlers::handleSetBacklash(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+    if (cmd.length() < 4) {
+        return CommandResult::ERROR_INVALID_FORMAT;
+    }
+
+    // Driver steps, like every other step count (microsteps on TMC drivers)
+    int steps = cmd.substring(3).toInt();
+    int maxSteps = BACKLASH_CAL_MAX_STEPS * (motorDriver ? motorDriver->getMicrosteps() : 1);
+    if (steps < 0 || steps > maxSteps) {
+        response = "ERROR:Invalid backlash (0-" + String(maxSteps) + ")";
+        return CommandResult::ERROR_INVALID_PARAMETER;
+    }
+
+    controller->setBacklashSteps(steps);
+    response = "BACKLASH:STEPS=" + String(steps);
+    return CommandResult::SUCCESS;
+}
+
+CommandResult CommandHandlers::handleSetApproachDirection(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+    if (cmd.length() < 5) {
+        return CommandResult::ERROR_INVALID_FORMAT;
+    }
+
+    // APPR0 = either side, APPR1 = forward, APPR-1 = backward
+    int direction = cmd.substring(4).toInt();
+    if (direction < -1 || direction > 1) {
+        return CommandResult::ERROR_INVALID_PARAMETER;
+    }
+
+    controller->setApproachDirection((int8_t)direction);
+    response = "BACKLASH:APPROACH=" + String(direction);
+    return CommandResult::SUCCESS;
+}
+
+CommandResult CommandHandlers::handlePidAutotune(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+    if (*isMoving) {
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+    if (!controller->startPidAutotune()) {
+        response = "ERROR:Encoder not available";
+        return CommandResult::ERROR_ENCODER_UNAVAILABLE;
+    }
+
+    response = "PIDTUNE:STARTED";
+    return CommandResult::SUCCESS;
+}
+
+CommandResult CommandHandlers::handleGetPidGains(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+
+    float kp, ki, kd;
+    controller->getPidGains(kp, ki, kd);
+    response = "PID:KP=" + String(kp, 3);
+    response += ",KI=" + String(ki, 3);
+    response += ",KD=" + String(kd, 3);
+    response += ",SOURCE=" + String(controller->hasCustomPidGains() ? "CUSTOM" : "DEFAULT");
+    return CommandResult::SUCCESS;
+}
+
+CommandResult CommandHandlers::handleSetPidGains(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+
+    // SPID[kp]:[ki]:[kd]
+    int firstColon = cmd.indexOf(':');
+    int secondColon = cmd.indexOf(':', firstColon + 1);
+    if (cmd.length() < 5 || firstColon < 0 || secondColon < 0) {
+        response = "ERROR:Invalid format. Use SPID[kp]:[ki]:[kd]";
+        return CommandResult::ERROR_INVALID_FORMAT;
+    }
+
+    float kp = cmd.substring(4, firstColon).toFloat();
+    float ki = cmd.substring(firstColon + 1, secondColon).toFloat();
+    float kd = cmd.substring(secondColon + 1).toFloat();
+    if (kp <= 0.0f || ki < 0.0f || kd < 0.0f) {
+        response = "ERROR:Gains must be positive (KP > 0)";
+        return CommandResult::ERROR_INVALID_PARAMETER;
+    }
+
+    controller->setPidGains(kp, ki, kd);
+    return handleGetPidGains(cmd, response);
+}
+
+CommandResult CommandHandlers::handleResetPidGains(const String& cmd, String& response) {
+    if (!controller) {
+        response = "ERROR:No controller";
+        return CommandResult::ERROR_SYSTEM_BUSY;
+    }
+
+    controller->resetPidGains();
+    return handleGetPidGains(cmd, response);
+}
+
 // ========================================
 // CUSTOM ANGLE CALIBRATION HANDLERS
 // ========================================
@@ -60,6 +60,21 @@ public:
      */
     CommandResult handleMoveToPosition(const String& cmd, String& response);
 
+    /**
+     * Queue positions - MQ[pos][:dwellMs],...
+     */
+    CommandResult handleQueueMoves(const String& cmd, String& response);
+
+    /**
+     * Get move queue progress - GQ
+     */
+    CommandResult handleGetQueueStatus(const String& cmd, String& response);
+
+    /**
+     * Clear move queue - CQ
+     */
+    CommandResult handleClearQueue(const String& cmd, String& response);
+
     /**
      * Set current position - SP[1-X]
      */
@@ -70,6 +85,11 @@ public:
      */
     CommandResult handleEmergencyStop(const String& cmd, String& response);
 
+    /**
+     * Enable/disable move events - EVT[0|1]
+     */
+    CommandResult handleSetEvents(const String& cmd, String& response);
+
     /**
      * Get system status - STATUS
      */
@@ -152,6 +172,66 @@ public:
      */
     CommandResult handleConfirmGuidedCalibration(const String& cmd, String& response);
 
+    /**
+     * Learn steps per revolution and position steps - CALSTEPS
+     */
+    CommandResult handleCalibrateSteps(const String& cmd, String& response);
+
+    /**
+     * Get step table - GSTEPS
+     */
+    CommandResult handleGetStepTable(const String& cmd, String& response);
+
+    /**
+     * Clear learned step table - CLEARSTEPS
+     */
+    CommandResult handleClearStepTable(const String& cmd, String& response);
+
+    /**
+     * Home against the hard stop - HOME
+     */
+    CommandResult handleSensorlessHoming(const String& cmd, String& response);
+
+    /**
+     * Measure backlash - CALBL
+     */
+    CommandResult handleCalibrateBacklash(const String& cmd, String& response);
+
+    /**
+     * Get backlash configuration - GBL
+     */
+    CommandResult handleGetBacklash(const String& cmd, String& response);
+
+    /**
+     * Set backlash steps - SBL[steps]
+     */
+    CommandResult handleSetBacklash(const String& cmd, String& response);
+
+    /**
+     * Set final approach direction - APPR[0|1|-1]
+     */
+    CommandResult handleSetApproachDirection(const String& cmd, String& response);
+
+    /**
+     * Autotune angle PID gains - PIDTUNE
+     */
+    CommandResult handlePidAutotune(const String& cmd, String& response);
+
+    /**
+     * Get angle PID gains - GPID
+     */
+    CommandResult handleGetPidGains(const String& cmd, String& response);
+
+    /**
+     * Set angle PID gains - SPID[kp]:[ki]:[kd]
+     */
+    CommandResult handleSetPidGains(const String& cmd, String& response);
+
+    /**
+     * Reset angle PID gains to defaults - RPID
+     */
+    CommandResult handleResetPidGains(const String& cmd, String& response);
+
     // ========================================
     // CUSTOM ANGLE CALIBRATION COMMANDS
     // ========================================
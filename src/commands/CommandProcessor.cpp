@@ -3,6 +3,8 @@
 CommandProcessor::CommandProcessor()
     : commandBuffer("")
     , debugMode(false)
+    , eventsEnabled(false)
+    , eventPrefix("")
     , numMappings(0)
     , stats{0, 0, 0, 0}
 {
@@ -93,6 +95,26 @@ void CommandProcessor::sendDebugMessage(const String& message) {
     }
 }
 
+void CommandProcessor::setEventsEnabled(bool enabled) {
+    eventsEnabled = enabled;
+}
+
+bool CommandProcessor::areEventsEnabled() const {
+    return eventsEnabled;
+}
+
+void CommandProcessor::sendEvent(const String& event) {
+    if (eventsEnabled) {
+        Serial.print("!EVT:");
+        Serial.print(eventPrefix);
+        Serial.println(event);
+    }
+}
+
+void CommandProcessor::setEventPrefix(const String& prefix) {
+    eventPrefix = prefix;
+}
+
 const char* CommandProcessor::getErrorString(CommandResult result) {
     switch (result) {
         case CommandResult::SUCCESS:
@@ -207,10 +229,11 @@ bool CommandProcessor::isValidCommand(const String& command) {
         return false;
     }
 
-    // Commands should only contain alphanumeric characters, colons, underscores, dots, and minus signs
+    // Commands should only contain alphanumeric characters, colons, underscores, dots, minus signs
+    // and commas (list parameters)
     for (size_t i = 0; i < command.length(); i++) {
         char c = command.charAt(i);
-        if (!isAlphaNumeric(c) && c != ':' && c != '_' && c != '.' && c != '-') {
+        if (!isAlphaNumeric(c) && c != ':' && c != '_' && c != '.' && c != '-' && c != ',') {
             return false;
         }
     }
@@ -33,6 +33,8 @@ class CommandProcessor {
 private:
     String commandBuffer;
     bool debugMode;
+    bool eventsEnabled;
+    String eventPrefix;
 
     // Command categories and their handlers
     struct CommandMapping {
@@ -94,6 +96,23 @@ public:
      */
     void sendDebugMessage(const String& message);
 
+    /**
+     * Enable/disable unsolicited event lines (off by default)
+     */
+    void setEventsEnabled(bool enabled);
+    bool areEventsEnabled() const;
+
+    /**
+     * Send an event line ("!EVT:" + event), only if events are enabled
+     * The '!' never starts a command response, so clients can tell them apart.
+     */
+    void sendEvent(const String& event);
+
+    /**
+     * Text put before every event (wheel address on multi-wheel boards)
+     */
+    void setEventPrefix(const String& prefix);
+
     /**
      * Get command result as error string
      */
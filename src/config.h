@@ -25,11 +25,44 @@
 // Motor configuration for 28BYJ-48
 #define STEPS_PER_REVOLUTION 2150  // 28BYJ-48 has 2048 steps per revolution (64 * 32)
 
-// Motor speed and acceleration
+// Step-based fallback positioning (no encoder)
+#define STEP_FALLBACK_SHORTEST_PATH true  // Move backwards when that is shorter (false = forward only)
+#define DEFAULT_BACKLASH_STEPS 0          // Gear play taken up on direction reversal (full steps)
+
+// Backlash calibration (#CALBL) and one-sided approach
+#define BACKLASH_CAL_PRELOAD_STEPS 100    // Forward full steps taking up the play before measuring
+#define BACKLASH_CAL_DETECT_ANGLE 0.3f    // Wheel travel that ends a probe (degrees, above encoder noise)
+#define BACKLASH_CAL_SETTLE_TIME 30       // Delay in ms after each probe step before reading
+#define BACKLASH_CAL_MAX_STEPS 300        // Give up if the wheel has not moved after this many full steps
+#define BACKLASH_APPROACH_DIRECTION 0     // Final approach side (0 = either, 1 = forward, -1 = backward)
+#define BACKLASH_APPROACH_OVERTRAVEL 2.0f // Overshoot before approaching from that side (degrees)
+
+// Revolution calibration (#CALSTEPS, learns steps/rev and per-position steps with the encoder)
+#define STEP_TABLE_LEAD_ANGLE 10.0f       // Wheel travel before positions are recorded (degrees)
+#define STEP_TABLE_MAX_STEPS 20000        // Give up if no full revolution was seen after this many full steps
+
+// Sensorless homing (#HOME, drivers with StallGuard, no encoder needed)
+// Drives into a hard stop until the driver reports a stall, then backs off
+// to filter 1. Once homed, step-based moves never cross the stop.
+#define HOMING_AT_STARTUP false           // Home at power-up when there is no encoder
+#define HOMING_DIRECTION 1                // Towards the stop (1 = forward, -1 = backward)
+#define HOMING_ORIGIN_ANGLE 10.0f         // Wheel travel from the stop back to filter 1 (degrees)
+#define HOMING_IGNORE_ANGLE 5.0f          // Stall readings ignored this close to either end (unreliable on the ramps)
+#define HOMING_SAMPLE_INTERVAL 5          // Delay in ms between stall readings (each one is a bus transfer)
+#define HOMING_SETTLE_TIME 50             // Delay in ms at the stop before backing off
+#define HOMING_MAX_ANGLE 380.0f           // Give up if no stall was seen after this much travel (degrees)
+
+// Motor speed and acceleration (full steps, independent of microstepping)
 #define MAX_MOTOR_SPEED 150.0      // Maximum steps per second
 #define MOTOR_ACCELERATION 1000.0  // Steps per second squared (increased for better response)
 #define MOTOR_SPEED 300.0          // Normal operating speed
 
+// Trajectory planner (precomputed step-gap ramp, see motion/TrajectoryPlanner.h)
+#define PLANNER_JERK 0.0f            // Jerk limit in full steps/s³ (0 = trapezoidal profile)
+#define FINE_APPROACH_ANGLE 3.0f     // End of a move stepped at full resolution (degrees, rest coarse)
+#define STEP_TIMER_ENABLED true      // Emit steps from a hardware timer interrupt (false = poll in loop)
+#define STEP_TIMER_NUMBER 0          // Hardware timer used for step generation (shared by all wheels)
+
 // ============================================
 // MOTOR DRIVER CONFIGURATION
 // ============================================
@@ -51,6 +84,12 @@
   #define MOTOR_PIN2 3   // IN2 on ULN2003 -> LED B
   #define MOTOR_PIN3 4   // IN3 on ULN2003 -> LED C
   #define MOTOR_PIN4 10 //10  // IN4 on ULN2003 -> LED D
+
+  // true = half-step positions (4096/rev on the 28BYJ-48); moves travel in
+  // full steps and only the final approach is half-stepped (see
+  // FINE_APPROACH_ANGLE). This changes the step unit: stored backlash and
+  // step calibration are then off by 2x, re-run #CALSTEPS and #CALBL.
+  #define ULN2003_HALF_STEP_APPROACH false
 #endif
 
 #ifdef MOTOR_DRIVER_TMC2209
@@ -75,9 +114,11 @@
   #define USE_STEALTHCHOP true       // Enable StealthChop (quiet mode)
   #define STEALTHCHOP_THRESHOLD 100  // Velocity threshold for StealthChop
   #define USE_COOLSTEP false         // Enable CoolStep (dynamic current control)
+  #define HOMING_STALL_THRESHOLD 64  // SGTHRS while homing: stall when SG_RESULT <= 2x this (higher = more sensitive)
 
   // Motor specifications (adjust for your motor)
   #define MOTOR_STEPS_PER_REV 200   // Full steps per revolution (200 for 1.8° motor, 400 for 0.9°)
+                                    // The controller plans in MOTOR_STEPS_PER_REV * microsteps
   #define MOTOR_HOLD_MULTIPLIER 0.5f // Hold current multiplier (0.0 to 1.0)
 
   // TMC2209 driver address (0-3, only if using multiple drivers on same UART)
@@ -111,9 +152,11 @@
   #define STEALTHCHOP_THRESHOLD 100  // Velocity threshold for StealthChop
   #define USE_STALLGUARD true        // Enable StallGuard (stall detection)
   #define STALLGUARD_THRESHOLD 8     // StallGuard threshold (lower = more sensitive)
+  #define HOMING_STALL_THRESHOLD 8   // SGT while homing (lower = more sensitive)
 
   // Motor specifications (adjust for your motor)
   #define MOTOR_STEPS_PER_REV 200   // Full steps per revolution (200 for 1.8° motor, 400 for 0.9°)
+                                    // The controller plans in MOTOR_STEPS_PER_REV * microsteps
   #define MOTOR_HOLD_MULTIPLIER 0.5f // Hold current multiplier (0.0 to 1.0)
 
   // Aliases for backward compatibility
@@ -152,6 +195,20 @@
 #define BUTTON_NEXT 9  // Button to move to next filter (changed from 6)
 #define BUTTON_PREV 7  // Button to move to previous filter
 
+// Multi-wheel (e.g. filter wheel + ND wheel, see core/MultiWheelController.h)
+// Extra wheels are TMC2209s on the wheel 1 UART at the driver addresses other
+// than TMC_DRIVER_ADDRESS (ascending), each with its own STEP/DIR/EN pins and
+// no encoder. Commands are addressed
+// as #2:MP3 (no address = wheel 1); every wheel has its own EEPROM block.
+#define WHEEL_COUNT 1                    // Wheels on this board (1-4)
+#define EXTRA_WHEEL_STEP_PINS {20}       // One entry per extra wheel (GPIO20/21 are free with USB CDC serial)
+#define EXTRA_WHEEL_DIR_PINS {21}
+#define EXTRA_WHEEL_ENABLE_PINS {0}
+
+#if WHEEL_COUNT > 1 && !defined(MOTOR_DRIVER_TMC2209) && !defined(ARDUINO_HOST)
+  #error "Extra wheels share the TMC2209 UART: select MOTOR_DRIVER_TMC2209"
+#endif
+
 // ============================================
 // AS5600 MAGNETIC ENCODER CONFIGURATION
 // ============================================
@@ -159,6 +216,17 @@
 #define AS5600_ADDRESS 0x36        // I2C address of AS5600
 #define AS5600_RAW_ANGLE_REGISTER 0x0C  // Register for raw angle
 #define AS5600_INVERT_DIRECTION true   // Invert encoder reading direction (360° - angle)
+#define AS5600_SNAPSHOT_MAX_AGE 50     // ms a register snapshot answers status/AGC/magnitude queries
+
+// Background sampling: the encoder is read at a fixed rate into a ring buffer
+// and angle readers (status, settle/slip/tracking checks, corrections,
+// calibration) take the latest sample; an idle wheel is sampled at a slower
+// rate (see encoders/EncoderSampler.h)
+#define ENCODER_SAMPLER_ENABLED true   // false = every reader does its own I2C read
+#define ENCODER_SAMPLE_INTERVAL 5      // ms between samples while moving or settling (task on ESP32, polled elsewhere); keep below SETTLE_SAMPLE_INTERVAL
+#define ENCODER_SAMPLE_MAX_AGE 10      // ms; an older latest sample falls back to a direct read
+#define ENCODER_IDLE_SAMPLE_INTERVAL 100  // ms between samples while idle
+#define ENCODER_IDLE_SAMPLE_MAX_AGE 250   // ms; idle readers accept a sample this old
 
 // Angle calibration and control
 #define ANGLE_TOLERANCE 5.0        // Degrees tolerance for position detection (verification only)
@@ -170,10 +238,42 @@
 #define ANGLE_PID_KP 4.5f          // Proportional gain
 #define ANGLE_PID_KI 0.01f         // Integral gain
 #define ANGLE_PID_KD 0.3f          // Derivative gain
+#define ANGLE_PID_REFERENCE_STEPS 2048.0f  // Driver steps/rev the gains are tuned for (scaled to the learned value)
 #define ANGLE_PID_INTEGRAL_MAX 100.0f  // Maximum integral accumulation (anti-windup)
-#define ANGLE_PID_OUTPUT_MIN 10    // Minimum motor steps per iteration
-#define ANGLE_PID_OUTPUT_MAX 2000   // Maximum motor steps per iteration
-#define ANGLE_PID_SETTLING_TIME 150  // Delay in ms after each movement
+#define ANGLE_PID_OUTPUT_MIN 10    // Minimum full steps per iteration
+#define ANGLE_PID_OUTPUT_MAX 2000   // Maximum full steps per iteration
+#define ANGLE_PID_SETTLING_TIME 150  // Max delay in ms after each movement
+#define ANGLE_VERIFY_SETTLING_TIME 200  // Max delay in ms before confirming the target reading
+
+// Settle detection: the settling times are upper bounds, the wait ends once
+// consecutive encoder samples show the wheel standing still
+#define SETTLE_DETECTION_ENABLED true      // false = always wait the full settling time
+#define SETTLE_SAMPLE_INTERVAL 10          // Encoder sample period while settling (ms)
+#define SETTLE_VELOCITY_THRESHOLD 20.0f    // Still below this between samples (degrees/s, above encoder noise)
+#define SETTLE_WINDOW 30                   // Time the wheel must stay still (ms)
+
+// PID autotune (relay feedback, gains stored in EEPROM override the above)
+#define PID_AUTOTUNE_RELAY_ANGLE 3.0f      // Relay move per iteration (degrees)
+#define PID_AUTOTUNE_HYSTERESIS 0.3f       // Error band where the relay keeps its direction (degrees)
+#define PID_AUTOTUNE_CYCLES 3              // Oscillation cycles averaged
+#define PID_AUTOTUNE_MAX_ITERATIONS 40     // Give up if the oscillation has not repeated by then
+
+// Continuous encoder tracking (retargets the step goal while moving)
+#define ANGLE_TRACKING_ENABLED false       // false = iterative PID (move, settle, read, repeat)
+#define ANGLE_TRACKING_INTERVAL 20         // Encoder sample period while moving (ms)
+#define ANGLE_TRACKING_ENGAGE_ANGLE 2.0f   // Wheel travel before retargeting starts (backlash taken up)
+#define ANGLE_TRACKING_SETTLING_TIME 50    // Max delay in ms after the approach before the final read
+
+// Feedforward planning (one calibrated move, the encoder only corrects the residual)
+#define ANGLE_FEEDFORWARD_ENABLED false    // true = takes precedence over ANGLE_TRACKING_ENABLED
+#define ANGLE_FEEDFORWARD_TRIM_STEPS 1.5f  // Residual (full steps) above which the one correction runs
+
+// Step-loss monitor (encoder moves): compares the steps issued with the wheel
+// travel while stepping and re-plans the rest of the move as soon as they part
+#define STEP_LOSS_DETECTION_ENABLED true   // false = slips only show in the settled read
+#define STEP_LOSS_CHECK_INTERVAL 10        // Encoder sample period while stepping (ms)
+#define STEP_LOSS_THRESHOLD 2.0f           // Lag beyond the compensated gear play that counts as lost;
+                                           // a wheel that moved less than this meanwhile is jammed (degrees)
 
 // Position angles for each filter (degrees)
 // These will be automatically calculated based on NUM_FILTERS
@@ -301,13 +401,22 @@
 #define POSITION_RETRY_COUNT 3      // Number of retries for positioning
 
 // Manual stepping configuration
-#define MAX_MANUAL_STEPS 4096       // Maximum steps allowed in one manual command (2 revolutions)
-#define MIN_MANUAL_STEPS 1          // Minimum steps for manual movement
+#define MAX_MANUAL_STEPS 4096       // Maximum full steps allowed in one manual command (2 revolutions)
+#define MIN_MANUAL_STEPS 1          // Minimum full steps for manual movement
 
 // Motor power management
+// After a move: full current for MOTOR_DISABLE_DELAY, then (with
+// MOTOR_HOLD_CURRENT, drivers with current control) reduced hold current
+// for MOTOR_HOLD_TIME, then off.
+// A move starting before the coils are off skips MOTOR_ENABLE_SETTLE_TIME.
 #define MOTOR_DISABLE_DELAY 500     // Time in ms to keep motor powered after movement (reduced to prevent heating)
 #define AUTO_DISABLE_MOTOR true     // Automatically disable motor after movement
-#define MOTOR_HOLD_CURRENT false    // Set to true if you want to keep position with reduced current
+#define MOTOR_HOLD_CURRENT false    // Set to true to keep position with MOTOR_HOLD_MULTIPLIER of the run current before switching off
+#ifndef MOTOR_HOLD_MULTIPLIER
+  #define MOTOR_HOLD_MULTIPLIER 0.5f // Drivers without current control never hold
+#endif
+#define MOTOR_HOLD_TIME 10000       // Time in ms at hold current before switching off
+#define MOTOR_ENABLE_SETTLE_TIME 20 // Delay in ms after energizing the coils (rotor snaps to a step)
 
 // Debug mode (set to 1 to enable debug output)
 #define DEBUG_MODE 0
@@ -1,8 +1,18 @@
 #include "ConfigManager.h"
 #include <EEPROM.h>
 
+ConfigManager::ConfigManager(uint8_t wheelIndex)
+    : baseAddress(getWheelBaseAddress(wheelIndex))
+{
+}
+
+uint16_t ConfigManager::getWheelBaseAddress(uint8_t wheelIndex) {
+    return (wheelIndex < MAX_WHEELS ? wheelIndex : 0) * EEPROM_SIZE;
+}
+
 void ConfigManager::init() {
-    EEPROM.begin(EEPROM_SIZE);
+    // Same size for every wheel, so each begin() maps all the blocks
+    EEPROM.begin(EEPROM_SIZE * MAX_WHEELS);
 }
 
 void ConfigManager::setCalibrated(bool calibrated) {
@@ -64,7 +74,7 @@ String ConfigManager::loadFilterName(uint8_t filterIndex) {
     if (!hasCustomFilterNames()) {
         // Return default names
         const char* defaultNames[] = {
-            "Luminance", "Red", "Green", "Blue", "H-Alpha", "Filter 6", "Filter 7", "Filter 8"
+            "Luminance", "Red", "Green", "Blue", "H-Alpha", "Filter 6", "Filter 7", "Filter 8", "Filter 9"
         };
         return String(defaultNames[filterIndex - 1]);
     }
@@ -174,7 +184,7 @@ void ConfigManager::clearMotorConfig() {
 void ConfigManager::factoryReset() {
     // Clear all EEPROM data
     for (uint16_t i = 0; i < EEPROM_SIZE; i++) {
-        EEPROM.write(i, 0x00);
+        EEPROM.write(baseAddress + i, 0x00);
     }
     EEPROM.commit();
 }
@@ -184,7 +194,9 @@ String ConfigManager::getConfigSummary() {
     summary += "Calibrated: " + String(isCalibrated() ? "YES" : "NO") + "\n";
     summary += "Filter Count: " + String(loadFilterCount()) + "\n";
     summary += "Custom Names: " + String(hasCustomFilterNames() ? "YES" : "NO") + "\n";
-    summary += "Motor Config: " + String(hasMotorConfig() ? "CUSTOM" : "DEFAULT");
+    summary += "Motor Config: " + String(hasMotorConfig() ? "CUSTOM" : "DEFAULT") + "\n";
+    summary += "Step Table: " + String(hasStepTable() ? "LEARNED" : "NOMINAL") + "\n";
+    summary += "PID Gains: " + String(hasPidGains() ? "CUSTOM" : "DEFAULT");
     return summary;
 }
 
@@ -207,19 +219,23 @@ bool ConfigManager::validateEEPROM() {
 ConfigManager::EEPROMStats ConfigManager::getEEPROMStats() {
     EEPROMStats stats;
     stats.totalSize = EEPROM_SIZE;
-    stats.usedSize = 0x12A; // Based on our current layout
+    stats.usedSize = EEPROM_PID_KD + sizeof(float); // Last block in the layout (0x18C)
     stats.freeSize = EEPROM_SIZE - stats.usedSize;
 
     stats.numStoredConfigs = 0;
     if (isCalibrated()) stats.numStoredConfigs++;
     if (hasCustomFilterNames()) stats.numStoredConfigs++;
     if (hasMotorConfig()) stats.numStoredConfigs++;
+    if (hasStepTable()) stats.numStoredConfigs++;
+    if (hasBacklashConfig()) stats.numStoredConfigs++;
+    if (hasPidGains()) stats.numStoredConfigs++;
 
     return stats;
 }
 
-// EEPROM utility methods
+// EEPROM utility methods (addresses are relative to this wheel's block)
 void ConfigManager::writeUint32(uint16_t address, uint32_t value) {
+    address += baseAddress;
     EEPROM.write(address, (value >> 24) & 0xFF);
     EEPROM.write(address + 1, (value >> 16) & 0xFF);
     EEPROM.write(address + 2, (value >> 8) & 0xFF);
@@ -228,6 +244,7 @@ void ConfigManager::writeUint32(uint16_t address, uint32_t value) {
 }
 
 uint32_t ConfigManager::readUint32(uint16_t address) {
+    address += baseAddress;
     uint32_t value = 0;
     value |= ((uint32_t)EEPROM.read(address)) << 24;
     value |= ((uint32_t)EEPROM.read(address + 1)) << 16;
@@ -237,12 +254,14 @@ uint32_t ConfigManager::readUint32(uint16_t address) {
 }
 
 void ConfigManager::writeUint16(uint16_t address, uint16_t value) {
+    address += baseAddress;
     EEPROM.write(address, (value >> 8) & 0xFF);
     EEPROM.write(address + 1, value & 0xFF);
     EEPROM.commit();
 }
 
 uint16_t ConfigManager::readUint16(uint16_t address) {
+    address += baseAddress;
     uint16_t value = 0;
     value |= ((uint16_t)EEPROM.read(address)) << 8;
     value |= EEPROM.read(address + 1);
@@ -250,11 +269,13 @@ uint16_t ConfigManager::readUint16(uint16_t address) {
 }
 
 void ConfigManager::writeUint8(uint16_t address, uint8_t value) {
+    address += baseAddress;
     EEPROM.write(address, value);
     EEPROM.commit();
 }
 
 uint8_t ConfigManager::readUint8(uint16_t address) {
+    address += baseAddress;
     return EEPROM.read(address);
 }
 
@@ -277,6 +298,7 @@ float ConfigManager::readFloat(uint16_t address) {
 }
 
 void ConfigManager::writeString(uint16_t address, const char* str, uint8_t maxLength) {
+    address += baseAddress;
     uint8_t len = strlen(str);
     if (len > maxLength) len = maxLength;
 
@@ -291,6 +313,7 @@ void ConfigManager::writeString(uint16_t address, const char* str, uint8_t maxLe
 }
 
 String ConfigManager::readString(uint16_t address, uint8_t maxLength) {
+    address += baseAddress;
     String result = "";
 
     for (uint8_t i = 0; i < maxLength; i++) {
@@ -374,4 +397,111 @@ void ConfigManager::saveEncoderDirectionInverted(bool inverted) {
     DirectionConfig config = loadDirectionConfig();
     config.encoderDirectionInverted = inverted;
     saveDirectionConfig(config.motorDirectionInverted, config.encoderDirectionInverted);
-}
\ No newline at end of file
+}
+// ========================================
+// LEARNED STEP TABLE
+// ========================================
+
+void ConfigManager::saveStepTable(uint16_t stepsPerRevolution, uint8_t count, const uint16_t* offsets) {
+    if (count < 1 || count > MAX_FILTER_COUNT) {
+        return;
+    }
+
+    writeUint16(EEPROM_STEPS_PER_REVOLUTION, stepsPerRevolution);
+    writeUint8(EEPROM_STEP_TABLE_COUNT, count);
+    for (uint8_t i = 0; i < count; i++) {
+        writeUint16(EEPROM_STEP_TABLE_START + i * sizeof(uint16_t), offsets[i]);
+    }
+
+    // Flag last, so an interrupted save leaves no half-written table
+    writeUint32(EEPROM_STEP_TABLE_FLAG, REVOLUTION_MAGIC);
+}
+
+uint16_t ConfigManager::loadStepTable(uint8_t& count, uint16_t* offsets) {
+    count = 0;
+    if (!hasStepTable()) {
+        return 0;
+    }
+
+    uint8_t stored = readUint8(EEPROM_STEP_TABLE_COUNT);
+    if (stored < 1 || stored > MAX_FILTER_COUNT) {
+        return 0;
+    }
+
+    count = stored;
+    for (uint8_t i = 0; i < count; i++) {
+        offsets[i] = readUint16(EEPROM_STEP_TABLE_START + i * sizeof(uint16_t));
+    }
+    return readUint16(EEPROM_STEPS_PER_REVOLUTION);
+}
+
+bool ConfigManager::hasStepTable() {
+    return readUint32(EEPROM_STEP_TABLE_FLAG) == REVOLUTION_MAGIC;
+}
+
+void ConfigManager::clearStepTable() {
+    writeUint32(EEPROM_STEP_TABLE_FLAG, 0);
+}
+
+// ========================================
+// BACKLASH CONFIGURATION
+// ========================================
+
+void ConfigManager::saveBacklashConfig(uint16_t steps, int8_t approachDirection) {
+    writeUint32(EEPROM_BACKLASH_FLAG, BACKLASH_MAGIC);
+    writeUint16(EEPROM_BACKLASH_STEPS, steps);
+    writeUint8(EEPROM_APPROACH_DIRECTION, (uint8_t)approachDirection);
+}
+
+ConfigManager::BacklashConfig ConfigManager::loadBacklashConfig() {
+    BacklashConfig config;
+
+    if (hasBacklashConfig()) {
+        config.steps = readUint16(EEPROM_BACKLASH_STEPS);
+        int8_t direction = (int8_t)readUint8(EEPROM_APPROACH_DIRECTION);
+        config.approachDirection = (direction > 0) ? 1 : (direction < 0) ? -1 : 0;
+    } else {
+        // Defaults - no compensation
+        config.steps = 0;
+        config.approachDirection = 0;
+    }
+
+    return config;
+}
+
+bool ConfigManager::hasBacklashConfig() {
+    return readUint32(EEPROM_BACKLASH_FLAG) == BACKLASH_MAGIC;
+}
+
+// ========================================
+// PID GAINS
+// ========================================
+
+void ConfigManager::savePidGains(float kp, float ki, float kd) {
+    writeFloat(EEPROM_PID_KP, kp);
+    writeFloat(EEPROM_PID_KI, ki);
+    writeFloat(EEPROM_PID_KD, kd);
+
+    // Flag last, so an interrupted save keeps the previous gains
+    writeUint32(EEPROM_PID_GAINS_FLAG, PID_GAINS_MAGIC);
+}
+
+ConfigManager::PidGainsConfig ConfigManager::loadPidGains() {
+    PidGainsConfig config = {0.0f, 0.0f, 0.0f};
+
+    if (hasPidGains()) {
+        config.kp = readFloat(EEPROM_PID_KP);
+        config.ki = readFloat(EEPROM_PID_KI);
+        config.kd = readFloat(EEPROM_PID_KD);
+    }
+
+    return config;
+}
+
+bool ConfigManager::hasPidGains() {
+    return readUint32(EEPROM_PID_GAINS_FLAG) == PID_GAINS_MAGIC;
+}
+
+void ConfigManager::clearPidGains() {
+    writeUint32(EEPROM_PID_GAINS_FLAG, 0);
+}
@@ -8,7 +8,7 @@
  */
 class ConfigManager {
 private:
-    // EEPROM Layout (matches current implementation)
+    // EEPROM Layout (matches current implementation), one block per wheel
     static constexpr uint16_t EEPROM_SIZE = 512;
 
     // Calibration flags
@@ -35,11 +35,30 @@ private:
     static constexpr uint16_t EEPROM_MOTOR_DIRECTION_INVERTED = 0x120; // 1 byte (bool)
     static constexpr uint16_t EEPROM_ENCODER_DIRECTION_INVERTED = 0x121; // 1 byte (bool)
 
+    // Learned step table (steps per revolution + step offset of each position),
+    // after the TMC (0x130) and display (0x144) settings of config.h
+    static constexpr uint16_t EEPROM_STEP_TABLE_FLAG = 0x158;       // 4 bytes
+    static constexpr uint16_t EEPROM_STEPS_PER_REVOLUTION = 0x15C;  // 2 bytes
+    static constexpr uint16_t EEPROM_STEP_TABLE_COUNT = 0x15E;      // 1 byte
+    static constexpr uint16_t EEPROM_STEP_TABLE_START = 0x160;      // 2 bytes per position x 9 = 18 bytes
+
+    // Backlash configuration
+    static constexpr uint16_t EEPROM_BACKLASH_FLAG = 0x174;         // 4 bytes
+    static constexpr uint16_t EEPROM_BACKLASH_STEPS = 0x178;        // 2 bytes
+    static constexpr uint16_t EEPROM_APPROACH_DIRECTION = 0x17A;    // 1 byte (int8: 0 = off, +1, -1)
+
+    // Angle PID gains (autotuned or set manually)
+    static constexpr uint16_t EEPROM_PID_GAINS_FLAG = 0x17C;        // 4 bytes
+    static constexpr uint16_t EEPROM_PID_KP = 0x180;                // 4 bytes (float)
+    static constexpr uint16_t EEPROM_PID_KI = 0x184;                // 4 bytes (float)
+    static constexpr uint16_t EEPROM_PID_KD = 0x188;                // 4 bytes (float)
+
     // Magic bytes for validation
     static constexpr uint32_t CALIBRATION_MAGIC = 0xAA;
     static constexpr uint32_t FILTER_NAMES_MAGIC = 0xBB;
     static constexpr uint32_t REVOLUTION_MAGIC = 0xCC;
     static constexpr uint32_t BACKLASH_MAGIC = 0xDD;
+    static constexpr uint32_t PID_GAINS_MAGIC = 0xAB;
     static constexpr uint32_t MOTOR_CONFIG_MAGIC = 0xEE;
     static constexpr uint32_t DIRECTION_CONFIG_MAGIC = 0xFF;
     static constexpr uint8_t CUSTOM_ANGLES_MAGIC = 0xCA;  // Custom Angles magic byte
@@ -57,9 +76,35 @@ private:
         bool encoderDirectionInverted;
     };
 
+    struct BacklashConfig {
+        uint16_t steps;
+        int8_t approachDirection;
+    };
+
+    struct PidGainsConfig {
+        float kp;
+        float ki;
+        float kd;
+    };
+
+    uint16_t baseAddress;   // Start of this wheel's block
+
 public:
     static constexpr uint8_t MAX_FILTER_COUNT = 9;
     static constexpr uint8_t MAX_FILTER_NAME_LENGTH = 15;
+    static constexpr uint8_t MAX_WHEELS = 4;
+
+    /**
+     * @param wheelIndex Configuration namespace: wheel 0 keeps the
+     *        single-wheel layout, wheel N uses the block N * EEPROM_SIZE
+     */
+    explicit ConfigManager(uint8_t wheelIndex = 0);
+
+    /**
+     * Start of a wheel's EEPROM block, for settings kept outside
+     * ConfigManager (TMC driver configuration)
+     */
+    static uint16_t getWheelBaseAddress(uint8_t wheelIndex);
 
     /**
      * Initialize EEPROM and load configuration
@@ -233,6 +278,80 @@ public:
     void saveMotorDirectionInverted(bool inverted);
     void saveEncoderDirectionInverted(bool inverted);
 
+    // ========================================
+    // LEARNED STEP TABLE
+    // ========================================
+
+    /**
+     * Save measured steps per revolution and per-position step offsets
+     * @param stepsPerRevolution Motor steps for one wheel revolution
+     * @param count Number of positions in the table
+     * @param offsets Steps from position 1 to each position, moving forward
+     */
+    void saveStepTable(uint16_t stepsPerRevolution, uint8_t count, const uint16_t* offsets);
+
+    /**
+     * Load the step table
+     * @param offsets Output array (must be at least 9 entries)
+     * @return Steps per revolution, or 0 if no table is stored
+     */
+    uint16_t loadStepTable(uint8_t& count, uint16_t* offsets);
+
+    /**
+     * Check if a step table is stored
+     */
+    bool hasStepTable();
+
+    /**
+     * Clear the step table (revert to the driver's nominal steps per revolution)
+     */
+    void clearStepTable();
+
+    // ========================================
+    // BACKLASH CONFIGURATION
+    // ========================================
+
+    /**
+     * Save backlash configuration
+     * @param steps Gear play taken up on a direction reversal
+     * @param approachDirection Final approach side (0 = off, +1 forward, -1 backward)
+     */
+    void saveBacklashConfig(uint16_t steps, int8_t approachDirection);
+
+    /**
+     * Load backlash configuration (defaults when none is stored)
+     */
+    BacklashConfig loadBacklashConfig();
+
+    /**
+     * Check if backlash configuration exists
+     */
+    bool hasBacklashConfig();
+
+    // ========================================
+    // PID GAINS
+    // ========================================
+
+    /**
+     * Save angle PID gains (steps per degree, per iteration)
+     */
+    void savePidGains(float kp, float ki, float kd);
+
+    /**
+     * Load angle PID gains (all zero when none are stored)
+     */
+    PidGainsConfig loadPidGains();
+
+    /**
+     * Check if PID gains are stored
+     */
+    bool hasPidGains();
+
+    /**
+     * Clear stored gains (revert to the compile-time defaults)
+     */
+    void clearPidGains();
+
     // ========================================
     // UTILITY METHODS
     // ========================================
@@ -0,0 +1,111 @@
+#include "Clock.h"
+
+#ifdef ARDUINO_HOST
+#include <ArduinoHost.h>
+#elif defined(ESP32)
+#include <esp_timer.h>
+#endif
+
+namespace {
+
+ArduinoClock defaultClock;
+Clock* installedClock = &defaultClock;
+
+#ifdef ARDUINO_HOST
+// Routes the shim's millis()/micros()/delay() through a virtual clock
+class ClockTimeSource : public arduino_host::TimeSource {
+public:
+    Clock* clock = nullptr;
+
+    uint64_t micros() override { return clock->micros(); }
+    void sleepMicros(uint32_t us) override { clock->delayMicroseconds(us); }
+};
+
+ClockTimeSource hostTimeSource;
+#endif
+
+} // namespace
+
+Clock& Clock::system() {
+    return *installedClock;
+}
+
+unsigned long IRAM_ATTR Clock::interruptMicros() {
+    #if defined(ESP32) && !defined(ARDUINO_HOST)
+    return (unsigned long)esp_timer_get_time();
+    #else
+    return ::micros();  // Follows an installed virtual clock on host builds
+    #endif
+}
+
+void Clock::install(Clock* clock) {
+    installedClock = clock ? clock : &defaultClock;
+
+    #ifdef ARDUINO_HOST
+    if (installedClock->isRealTime()) {
+        arduino_host::setTimeSource(nullptr);
+    } else {
+        hostTimeSource.clock = installedClock;
+        arduino_host::setTimeSource(&hostTimeSource);
+    }
+    #endif
+}
+
+void SimulatedClock::advanceTo(uint64_t target) {
+    // Fire due alarms in deadline order; a callback may re-arm itself
+    for (;;) {
+        Alarm* next = nullptr;
+        for (uint8_t i = 0; i < alarmCount; i++) {
+            Alarm* alarm = alarms[i];
+            if (alarm->armed && alarm->deadline <= target &&
+                (!next || alarm->deadline < next->deadline)) {
+                next = alarm;
+            }
+        }
+        if (!next) {
+            break;
+        }
+        if (next->deadline > nowMicros) {
+            nowMicros = next->deadline;
+        }
+        next->armed = false;
+        next->onAlarm();
+    }
+    if (target > nowMicros) {
+        nowMicros = target;
+    }
+}
+
+bool SimulatedClock::setAlarm(Alarm* alarm, uint64_t deadlineMicros) {
+    bool registered = false;
+    for (uint8_t i = 0; i < alarmCount; i++) {
+        if (alarms[i] == alarm) {
+            registered = true;
+            break;
+        }
+    }
+    if (!registered) {
+        if (alarmCount >= MAX_ALARMS) {
+            return false;
+        }
+        alarms[alarmCount++] = alarm;
+    }
+
+    alarm->deadline = deadlineMicros;
+    alarm->armed = true;
+    return true;
+}
+
+void SimulatedClock::cancelAlarm(Alarm* alarm) {
+    alarm->armed = false;
+}
+
+void SimulatedClock::removeAlarm(Alarm* alarm) {
+    for (uint8_t i = 0; i < alarmCount; i++) {
+        if (alarms[i] == alarm) {
+            alarms[i] = alarms[--alarmCount];
+            alarm->armed = false;
+            return;
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/**
+ * Time source used by the firmware instead of calling millis()/delay() directly
+ * ArduinoClock is installed by default; SimulatedClock replaces waiting with an
+ * instant jump of virtual time so simulated runs are fast and reproducible.
+ */
+class Clock {
+public:
+    virtual ~Clock() = default;
+
+    virtual unsigned long millis() = 0;
+    virtual unsigned long micros() = 0;
+    virtual void delay(uint32_t ms) = 0;
+    virtual void delayMicroseconds(uint32_t us) = 0;
+
+    /**
+     * True if time follows the wall clock (false for virtual time)
+     */
+    virtual bool isRealTime() const { return true; }
+
+    /**
+     * Currently installed clock
+     */
+    static Clock& system();
+
+    /**
+     * micros() of the installed clock for interrupt handlers: no virtual
+     * call, as the vtable is in flash on the ESP32
+     */
+    static unsigned long interruptMicros();
+
+    /**
+     * Install a clock for the whole firmware (nullptr restores ArduinoClock)
+     * On host builds a virtual clock also drives the Arduino time functions,
+     * so libraries such as AccelStepper follow it.
+     */
+    static void install(Clock* clock);
+};
+
+/**
+ * Wall-clock time from the Arduino core
+ */
+class ArduinoClock : public Clock {
+public:
+    unsigned long millis() override { return ::millis(); }
+    unsigned long micros() override { return ::micros(); }
+    void delay(uint32_t ms) override { ::delay(ms); }
+    void delayMicroseconds(uint32_t us) override { ::delayMicroseconds(us); }
+};
+
+/**
+ * Virtual time: delays advance the clock instantly, nothing else does
+ * Alarms stand in for hardware timer interrupts: while time advances, each
+ * armed alarm fires at exactly its deadline, in deadline order.
+ */
+class SimulatedClock : public Clock {
+public:
+    /**
+     * Callback fired at a virtual deadline (see SimulatedStepTimer)
+     */
+    class Alarm {
+    public:
+        virtual ~Alarm() = default;
+        virtual void onAlarm() = 0;
+
+    private:
+        friend class SimulatedClock;
+        uint64_t deadline = 0;
+        bool armed = false;
+    };
+
+    static constexpr uint8_t MAX_ALARMS = 4;
+
+private:
+    uint64_t nowMicros;
+    Alarm* alarms[MAX_ALARMS];
+    uint8_t alarmCount;
+
+    void advanceTo(uint64_t target);
+
+public:
+    explicit SimulatedClock(uint64_t startMicros = 0)
+        : nowMicros(startMicros), alarms{}, alarmCount(0) {}
+
+    unsigned long millis() override { return (unsigned long)(nowMicros / 1000); }
+    unsigned long micros() override { return (unsigned long)nowMicros; }
+    void delay(uint32_t ms) override { advanceTo(nowMicros + (uint64_t)ms * 1000); }
+    void delayMicroseconds(uint32_t us) override { advanceTo(nowMicros + us); }
+    bool isRealTime() const override { return false; }
+
+    void advance(uint32_t us) { advanceTo(nowMicros + us); }
+    void setMicros(uint64_t us) { nowMicros = us; }
+    uint64_t getMicros64() const { return nowMicros; }
+
+    /**
+     * Arm (or re-arm) an alarm at an absolute virtual time
+     * @return false if MAX_ALARMS different alarms are already registered
+     */
+    bool setAlarm(Alarm* alarm, uint64_t deadlineMicros);
+
+    /**
+     * Disarm an alarm (it stays registered)
+     */
+    void cancelAlarm(Alarm* alarm);
+
+    /**
+     * Forget an alarm (call before destroying it)
+     */
+    void removeAlarm(Alarm* alarm);
+};
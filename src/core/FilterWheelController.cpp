@@ -2,6 +2,7 @@
 #include "../drivers/MotorDriverFactory.h"
 #include "../encoders/AS5600Encoder.h"
 #include "../config.h"
+#include "Clock.h"
 #include <Wire.h>
 
 // C++11 compatibility helper for make_unique
@@ -10,24 +11,84 @@ std::unique_ptr<T> make_unique_compat(Args&&... args) {
     return std::unique_ptr<T>(new T(std::forward<Args>(args)...));
 }
 
-FilterWheelController::FilterWheelController()
-    : currentPosition(1)
+FilterWheelController::FilterWheelController(uint8_t wheelIndex)
+    : trackedSampleTime(0)
+    , currentPosition(1)
     , numFilters(5)
     , targetPosition(1)
     , isCalibrated(true)
     , isMoving(false)
-    , motorEnabled(false)
+    , motorPowerState(MotorPowerState::OFF)
     , errorCode(0)
     , needsCalibration(false)
     , inCalibrationMode(false)
     , lastUpdate(0)
-    , motorDisableTime(0)
+    , powerStateSince(0)
     , motorDisablePending(false)
     , movementStartTime(0)
+    , lastIdleCheck(0)
+    , motionState(MotionState::IDLE)
+    , motionUsesEncoder(false)
+    , motionTargetAngle(0.0f)
+    , pidIntegralSum(0.0f)
+    , pidPreviousError(0.0f)
+    , pidIteration(0)
+    , motionVerified(false)
+    , settleStartTime(0)
+    , settleDuration(0)
+    , lastSettleSample(0)
+    , lastSettleAngle(0.0f)
+    , stillSince(0)
+    , settleSampled(false)
+    , settledByVelocity(false)
+    , lastStepSpeed(0.0f)
+    , encoderControlMode(ANGLE_FEEDFORWARD_ENABLED ? EncoderControlMode::FEEDFORWARD
+                         : ANGLE_TRACKING_ENABLED ? EncoderControlMode::TRACKING
+                                                  : EncoderControlMode::ITERATIVE)
+    , lastTrackingSample(0)
+    , trackingStartAngle(0.0f)
+    , trackingStartSteps(0)
+    , stepLossDetectionEnabled(STEP_LOSS_DETECTION_ENABLED)
+    , lastSlipCheck(0)
+    , slipLastAngle(0.0f)
+    , slipWheelTravel(0.0f)
+    , slipStartSteps(0)
+    , shortestPathEnabled(STEP_FALLBACK_SHORTEST_PATH)
+    , backlashSteps(DEFAULT_BACKLASH_STEPS)
+    , lastMoveDirection(0)
+    , approachDirection(BACKLASH_APPROACH_DIRECTION)
+    , pendingApproachSteps(0)
+    , segmentErrorOffset(0.0f)
+    , stepsPerRevolution(0)
+    , stepTableCount(0)
+    , calibrationRoutine(CalibrationRoutine::REVOLUTION)
+    , calibrationReturnPosition(1)
+    , backlashProbeDirection(0)
+    , backlashProbeSteps(0)
+    , backlashReferenceAngle(0.0f)
+    , backlashMeasurements(0)
+    , homingPhase(HomingPhase::SEEKING)
+    , homingStartSteps(0)
+    , lastStallSample(0)
+    , homedToStop(false)
+    , pidKp(ANGLE_PID_KP)
+    , pidKi(ANGLE_PID_KI)
+    , pidKd(ANGLE_PID_KD)
+    , pidGainsCustom(false)
+    , autotuneSetpoint(0.0f)
+    , queueLength(0)
+    , queueIndex(0)
+    , queueCompleted(0)
+    , queueState(QueueState::IDLE)
+    , queueMoveRunning(false)
+    , queueNextPrepared(false)
+    , dwellStartTime(0)
+    , wheelIndex(wheelIndex)
     , displayUpdateInterval(100)
-    , motorDisableDelay(1000)
+    , motorDisableDelay(MOTOR_DISABLE_DELAY)
     , debugMode(false)
 {
+    lastMoveStats = MoveStats();
 }
 
 FilterWheelController::~FilterWheelController() {
@@ -39,6 +100,34 @@ bool FilterWheelController::init(MotorDriverType motorType) {
         return false;
     }
 
+    return initializeComponents();
+}
+
+bool FilterWheelController::init(std::unique_ptr<MotorDriver> driver,
+                                 std::unique_ptr<EncoderInterface> encoderInstance) {
+    if (!driver) {
+        return false;
+    }
+
+    motorDriver = std::move(driver);
+    encoder = std::move(encoderInstance);
+
+    return initializeComponents();
+}
+
+bool FilterWheelController::initializeComponents() {
+    // Filter moves are stepped from a precomputed profile
+    stepGenerator = make_unique_compat<StepGenerator>(motorDriver.get());
+    // Everything below plans in driver steps (microsteps on TMC drivers)
+    stepsPerRevolution = motorDriver->getMicrostepsPerRevolution();  // Until a table is loaded
+    backlashSteps = DEFAULT_BACKLASH_STEPS * motorDriver->getMicrosteps();  // Until a config is loaded
+
+    #if STEP_TIMER_ENABLED
+    // Hardware timer where available, otherwise steps are polled from update()
+    // (MultiWheelController swaps in a channel of its shared step scheduler)
+    setStepTimer(StepTimer::createPlatformTimer(STEP_TIMER_NUMBER));
+    #endif
+
     if (!initializeDisplay()) {
         return false;
     }
@@ -49,7 +138,7 @@ bool FilterWheelController::init(MotorDriverType motorType) {
 
     // Initialize configuration manager BEFORE command system
     // (command handlers need access to configManager)
-    configManager = make_unique_compat<ConfigManager>();
+    configManager = make_unique_compat<ConfigManager>(wheelIndex);
     configManager->init();
 
     // Load system configuration
@@ -65,7 +154,7 @@ bool FilterWheelController::init(MotorDriverType motorType) {
 
     // After splash screen, show initial state (always READY)
     if (displayManager) {
-        delay(1500);  // Let splash screen display for a moment
+        Clock::system().delay(1500);  // Let splash screen display for a moment
         displayManager->showFilterWheelState(
             "READY",
             currentPosition,
@@ -75,17 +164,34 @@ bool FilterWheelController::init(MotorDriverType motorType) {
         );
     }
 
+    #if HOMING_AT_STARTUP
+    // Without an encoder the step origin comes from the hard stop
+    if (!encoder || !encoder->isAvailable()) {
+        startSensorlessHoming();
+    }
+    #endif
+
     return true;
 }
 
 void FilterWheelController::update() {
-    unsigned long currentTime = millis();
+    unsigned long currentTime = Clock::system().millis();
+
+    // Full sample rate while the wheel moves or settles, idle rate otherwise;
+    // sampled from here when no background task does
+    if (encoderSampler) {
+        encoderSampler->setActive(isMoving);
+        encoderSampler->poll();
+    }
 
-    // Update motor movement
+    // Update motor movement, then start the next queued move in the same pass
     updateMotorMovement();
+    updateMoveQueue();
 
-    // Update display
-    updateDisplay();
+    // Update display (not while stepping: an I2C refresh stalls step generation)
+    if (!isMoving || motionState == MotionState::SETTLING) {
+        updateDisplay();
+    }
 
     // Update motor power management
     updateMotorPowerManagement();
@@ -124,99 +230,542 @@ bool FilterWheelController::moveToPosition(uint8_t position) {
         return false;
     }
 
+    if (!motorDriver) {
+        return false;
+    }
+
     targetPosition = position;
-    bool success = false;
+    isMoving = true;
+    movementStartTime = Clock::system().millis();
 
-    // Show moving state
-    if (displayManager) {
+    lastMoveStats = MoveStats();
+    lastMoveStats.fromPosition = currentPosition;
+    lastMoveStats.toPosition = position;
+    emitMoveEvent(MoveEvent::STARTED);
+
+    // Show moving state (a back-to-back queued move already shows it)
+    if (displayManager && !queueNextPrepared) {
         displayManager->showFilterWheelState("MOVING", currentPosition, numFilters,
                                             getFilterName(currentPosition).c_str(), true);
     }
 
+    // A new move cancels any pending power-down. Coils that were off pull
+    // the rotor into a step first; within the hold window there is no wait.
+    if (powerUpMotor()) {
+        settleStartTime = Clock::system().millis();
+        motionState = MotionState::ENERGIZING;
+        return true;
+    }
+
+    beginMove();
+    return true;
+}
+
+void FilterWheelController::beginMove() {
     // ENCODER-BASED CONTROL: Use angle feedback if encoder is available
     if (encoder && encoder->isAvailable()) {
-        #if DEBUG_MODE
-        Serial.println("[moveToPosition] Using ENCODER-BASED control");
-        #endif
+        motionUsesEncoder = true;
+        motionTargetAngle = positionToAngle(targetPosition);
+        pidIntegralSum = 0.0f;
+        pidPreviousError = 0.0f;
+        pidIteration = 0;
+        motionVerified = false;
 
-        // Convert target position to angle
-        float targetAngle = positionToAngle(position);
         #if DEBUG_MODE
-        Serial.print("[moveToPosition] Target angle: ");
-        Serial.print(targetAngle, 2);
+        Serial.print("[moveToPosition] Using ENCODER-BASED control, target angle: ");
+        Serial.print(motionTargetAngle, 2);
         Serial.println("°");
         #endif
 
-        // Use encoder feedback for precise positioning
-        success = moveToAngleWithFeedback(targetAngle, ANGLE_CONTROL_TOLERANCE);
+        evaluateEncoderPosition();
+    } else {
+        // STEP-BASED CONTROL: no encoder available
+        startStepMove();
+    }
+}
+
+FilterWheelController::MotionState FilterWheelController::getMotionState() const {
+    return motionState;
+}
 
-        #if DEBUG_MODE
-        if (success) {
-            Serial.println("[moveToPosition] Encoder-based positioning succeeded");
-        } else {
-            Serial.println("[moveToPosition] WARNING: Encoder-based positioning failed, falling back to step-based");
+void FilterWheelController::setShortestPathEnabled(bool enabled) {
+    shortestPathEnabled = enabled;
+}
+
+bool FilterWheelController::isShortestPathEnabled() const {
+    return shortestPathEnabled;
+}
+
+void FilterWheelController::setBacklashSteps(int steps) {
+    backlashSteps = (steps > 0) ? steps : 0;
+    if (configManager) {
+        configManager->saveBacklashConfig(backlashSteps, approachDirection);
+    }
+}
+
+int FilterWheelController::getBacklashSteps() const {
+    return backlashSteps;
+}
+
+void FilterWheelController::setApproachDirection(int8_t direction) {
+    approachDirection = (direction > 0) ? 1 : (direction < 0) ? -1 : 0;
+    if (configManager) {
+        configManager->saveBacklashConfig(backlashSteps, approachDirection);
+    }
+}
+
+int8_t FilterWheelController::getApproachDirection() const {
+    return approachDirection;
+}
+
+void FilterWheelController::setEncoderControlMode(EncoderControlMode mode) {
+    encoderControlMode = mode;
+}
+
+FilterWheelController::EncoderControlMode FilterWheelController::getEncoderControlMode() const {
+    return encoderControlMode;
+}
+
+void FilterWheelController::setStepLossDetectionEnabled(bool enabled) {
+    stepLossDetectionEnabled = enabled;
+}
+
+bool FilterWheelController::isStepLossDetectionEnabled() const {
+    return stepLossDetectionEnabled;
+}
+
+const char* FilterWheelController::getMotionStateName() const {
+    switch (motionState) {
+        case MotionState::IDLE:         return "IDLE";
+        case MotionState::ENERGIZING:   return "ENERGIZING";
+        case MotionState::ACCELERATING: return "ACCELERATING";
+        case MotionState::CRUISING:     return "CRUISING";
+        case MotionState::DECELERATING: return "DECELERATING";
+        case MotionState::CORRECTING:   return "CORRECTING";
+        case MotionState::SETTLING:     return "SETTLING";
+        case MotionState::CALIBRATING:  return "CALIBRATING";
+        case MotionState::DONE:         return "DONE";
+    }
+    return "UNKNOWN";
+}
+
+void FilterWheelController::startStepMove() {
+    motionUsesEncoder = false;
+
+    #if DEBUG_MODE
+    Serial.println("[moveToPosition] Using STEP-BASED control");
+    #endif
+
+    long steps = calculateStepsToPosition(targetPosition);
+    if (steps == 0) {
+        // Already at target position
+        completeMove(true);
+        return;
+    }
+
+    // Arriving from the wrong side: overshoot, then come back (see updateMotorMovement)
+    pendingApproachSteps = 0;
+    if (approachDirection != 0 && (steps > 0 ? 1 : -1) != approachDirection) {
+        long overtravel = lround(BACKLASH_APPROACH_OVERTRAVEL * stepsPerRevolution / 360.0f);
+        steps -= approachDirection * overtravel;
+        pendingApproachSteps = approachDirection * overtravel;
+    }
+
+    #if DEBUG_MODE
+    Serial.print("[moveToPosition] Moving ");
+    Serial.print(steps);
+    Serial.println(" steps");
+    #endif
+
+    powerUpMotor();
+    lastMoveStats.stepsIssued += abs(startMotorMove(steps));
+    motionState = MotionState::ACCELERATING;
+}
+
+void FilterWheelController::startSettling(uint16_t durationMs) {
+    settleStartTime = Clock::system().millis();
+    settleDuration = durationMs;
+    settleSampled = false;
+    settledByVelocity = false;
+    motionState = MotionState::SETTLING;
+}
+
+bool FilterWheelController::updateSettleDetection() {
+    unsigned long now = Clock::system().millis();
+    if (now - settleStartTime >= settleDuration) {
+        return true;
+    }
+    if (!SETTLE_DETECTION_ENABLED) {
+        return false;
+    }
+    if (settleSampled && now - lastSettleSample < SETTLE_SAMPLE_INTERVAL) {
+        return false;
+    }
+
+    float angle = readEncoderAngle();
+    if (angle < 0) {
+        return false;  // Read failed, the settle time still bounds the wait
+    }
+
+    if (!settleSampled) {
+        settleSampled = true;
+        stillSince = now;
+    } else {
+        // Velocity between consecutive samples; any fast sample restarts the window
+        float velocity = abs(calculateAngularError(lastSettleAngle, angle)) * 1000.0f
+                       / (now - lastSettleSample);
+        if (velocity > SETTLE_VELOCITY_THRESHOLD) {
+            stillSince = now;
+        } else if (now - stillSince >= SETTLE_WINDOW) {
+            settledByVelocity = true;
         }
+    }
+    lastSettleAngle = angle;
+    lastSettleSample = now;
+    return settledByVelocity;
+}
+
+void FilterWheelController::evaluateEncoderPosition() {
+    // Read current angle from encoder
+    float currentAngle = readEncoderAngle();
+    if (currentAngle < 0) {
+        #if DEBUG_MODE
+        Serial.println("[PID] ERROR: Failed to read encoder angle");
         #endif
+        setError(1);
+        startStepMove();
+        return;
+    }
+
+    // Calculate error (with wraparound handling)
+    float error = calculateAngularError(currentAngle, motionTargetAngle);
+
+    // Feedforward spends its one correction on any residual of a few steps,
+    // not only on one outside the acceptance tolerance
+    bool reached = abs(error) <= ANGLE_CONTROL_TOLERANCE;
+    if (reached && encoderControlMode == EncoderControlMode::FEEDFORWARD && pidIteration == 1) {
+        float trimAngle = ANGLE_FEEDFORWARD_TRIM_STEPS * motorDriver->getMicrosteps() * 360.0f / stepsPerRevolution;
+        reached = abs(error) <= trimAngle;
     }
 
-    // STEP-BASED CONTROL: Fallback if encoder not available or encoder control failed
-    if (!success) {
+    // Check if we've reached target
+    if (reached) {
+        // Tracking watched the whole approach and feedforward settled fully,
+        // one settled read is enough for them. So is a read after the wheel
+        // was seen standing still.
+        if (!motionVerified && !settledByVelocity
+            && encoderControlMode == EncoderControlMode::ITERATIVE) {
+            // Confirm after the mechanism has settled completely
+            motionVerified = true;
+            startSettling(ANGLE_VERIFY_SETTLING_TIME);
+            return;
+        }
+
         #if DEBUG_MODE
-        Serial.println("[moveToPosition] Using STEP-BASED control (fallback)");
+        Serial.print("[PID] ✓ TARGET REACHED in ");
+        Serial.print(pidIteration);
+        Serial.print(" iterations, final error: ");
+        Serial.print(error, 2);
+        Serial.println("°");
         #endif
 
-        int steps = calculateStepsToPosition(position);
+        completeMove(true);
+        return;
+    }
+
+    // Position drifted after settling (or not there yet): keep correcting
+    motionVerified = false;
+
+    if (pidIteration >= ANGLE_CONTROL_MAX_ITERATIONS) {
         #if DEBUG_MODE
-        Serial.print("[moveToPosition] Calculated steps: ");
-        Serial.println(steps);
+        Serial.println("[PID] ✗ FAILED to reach target, falling back to step-based control");
         #endif
+        setError(1); // Positioning error
+        startStepMove();
+        return;
+    }
 
-        if (steps == 0) {
-            // Already at target position
-            success = true;
-        } else {
-            // Apply backlash compensation
-            steps = applyBacklashCompensation(steps);
+    // Approach from one side: aim past the target when arriving from the
+    // other, the next segment then comes back the right way. From here on
+    // error is the distance to that aim point.
+    segmentErrorOffset = 0.0f;
+    if (approachDirection != 0 && (error > 0 ? 1 : -1) != approachDirection) {
+        segmentErrorOffset = -approachDirection * BACKLASH_APPROACH_OVERTRAVEL;
+    }
+    error += segmentErrorOffset;
 
-            // Enable motor first
-            motorDriver->enableMotor();
+    // Every segment starts stepping from here
+    startStepLossMonitor(currentAngle);
 
-            // Execute movement
-            #if DEBUG_MODE
-            Serial.println("[moveToPosition] Starting motor movement...");
-            #endif
-            if (steps > 0) {
-                #if DEBUG_MODE
-                Serial.print("[moveToPosition] Moving forward ");
-                Serial.print(steps);
-                Serial.println(" steps");
-                #endif
-                motorDriver->stepForward(steps);
-            } else if (steps < 0) {
-                #if DEBUG_MODE
-                Serial.print("[moveToPosition] Moving backward ");
-                Serial.print(-steps);
-                Serial.println(" steps");
-                #endif
-                motorDriver->stepBackward(-steps);  // stepBackward expects positive value
-            }
+    if (encoderControlMode == EncoderControlMode::TRACKING) {
+        startTrackingSegment(error, currentAngle);
+        pidIteration++;
+        return;
+    }
+    if (encoderControlMode == EncoderControlMode::FEEDFORWARD) {
+        startFeedforwardMove(error, currentAngle);
+        pidIteration++;
+        return;
+    }
 
-            #if DEBUG_MODE
-            Serial.println("[moveToPosition] Movement completed");
-            #endif
-            success = true;
+    // ============================================
+    // PID CALCULATION
+    // ============================================
+
+    float kp, ki, kd;
+    getPidGains(kp, ki, kd);
+
+    // Proportional term: directly proportional to error
+    float proportional = kp * error;
+
+    // Integral term: accumulates error over time (anti-windup protection)
+    pidIntegralSum += error;
+    if (pidIntegralSum > ANGLE_PID_INTEGRAL_MAX) pidIntegralSum = ANGLE_PID_INTEGRAL_MAX;
+    if (pidIntegralSum < -ANGLE_PID_INTEGRAL_MAX) pidIntegralSum = -ANGLE_PID_INTEGRAL_MAX;
+    float integral = ki * pidIntegralSum;
+
+    // Derivative term: rate of change of error (dampens oscillation)
+    float derivative = kd * (error - pidPreviousError);
+
+    // PID output (in steps)
+    int stepsNeeded = (int)(proportional + integral + derivative);
+
+    // The minimum output pushes small corrections through the gear play.
+    // With the play compensated it only has to beat friction, and must stay
+    // inside the tolerance band or corrections overshoot back and forth.
+    // Both limits are in full steps.
+    int microsteps = motorDriver->getMicrosteps();
+    int outputMin = ANGLE_PID_OUTPUT_MIN * microsteps;
+    int outputMax = ANGLE_PID_OUTPUT_MAX * microsteps;
+    if (backlashSteps > 0) {
+        int bandSteps = (int)(ANGLE_CONTROL_TOLERANCE * stepsPerRevolution / 360.0f);
+        if (bandSteps < outputMin) {
+            outputMin = (bandSteps > 1) ? bandSteps : 1;
+        }
+    }
 
-            // Disable motor after step-based movement
-            if (motorDriver) {
-                motorDriver->disableMotor();
-                #if DEBUG_MODE
-                Serial.println("[moveToPosition] Motor disabled (step-based control)");
-                #endif
-            }
+    // Apply output limits (prevent too large/small movements)
+    if (abs(stepsNeeded) > outputMax) {
+        stepsNeeded = (stepsNeeded > 0) ? outputMax : -outputMax;
+    }
+    if (abs(stepsNeeded) < outputMin) {
+        stepsNeeded = (error > 0) ? outputMin : -outputMin;
+    }
+
+    // Overshoot prevention: reduce steps when very close to target
+    // This compensates for motor inertia and mechanical lag (tuned gains
+    // were measured on this wheel and already account for it)
+    if (!pidGainsCustom && abs(error) < 5.0f) {
+        stepsNeeded = (int)(stepsNeeded * 0.7f);
+        if (abs(stepsNeeded) < outputMin) {
+            stepsNeeded = (error > 0) ? outputMin : -outputMin;
         }
     }
 
-    // Update position if movement was successful
+    #if DEBUG_MODE
+    Serial.print("[PID] Iter ");
+    Serial.print(pidIteration + 1);
+    Serial.print(": Angle=");
+    Serial.print(currentAngle, 2);
+    Serial.print("° Err=");
+    Serial.print(error, 2);
+    Serial.print("° | P=");
+    Serial.print(proportional, 1);
+    Serial.print(" I=");
+    Serial.print(integral, 1);
+    Serial.print(" D=");
+    Serial.print(derivative, 1);
+    Serial.print(" → ");
+    Serial.print(stepsNeeded);
+    Serial.println(" steps");
+    #endif
+
+    // Execute movement (non-blocking, stepped from update())
+    lastMoveStats.iterations++;
+    lastMoveStats.stepsIssued += abs(startMotorMove(stepsNeeded));
+
+    // First move is the main approach, later ones are corrections
+    motionState = (pidIteration == 0) ? MotionState::ACCELERATING : MotionState::CORRECTING;
+
+    pidPreviousError = error;
+    pidIteration++;
+}
+
+void FilterWheelController::startTrackingSegment(float error, float currentAngle) {
+    float stepsPerDegree = stepsPerRevolution / 360.0f;
+    long stepsNeeded = lround(error * stepsPerDegree);
+    if (stepsNeeded == 0) {
+        stepsNeeded = (error > 0) ? 1 : -1;
+    }
+
+    #if DEBUG_MODE
+    Serial.print("[TRACK] Segment ");
+    Serial.print(pidIteration + 1);
+    Serial.print(": Angle=");
+    Serial.print(currentAngle, 2);
+    Serial.print("° Err=");
+    Serial.print(error, 2);
+    Serial.print("° → ");
+    Serial.print(stepsNeeded);
+    Serial.println(" steps");
+    #endif
+
+    trackingStartAngle = currentAngle;
+    trackingStartSteps = motorDriver->getCurrentPosition();
+    lastTrackingSample = Clock::system().millis();
+
+    lastMoveStats.iterations++;
+    startMotorMove(stepsNeeded);
+    motionState = (pidIteration == 0) ? MotionState::ACCELERATING : MotionState::CORRECTING;
+}
+
+void FilterWheelController::startFeedforwardMove(float error, float currentAngle) {
+    // Calibrated model instead of a gain: the bulk move lands within the
+    // encoder tolerance, the settled read after it only trims the rest
+    long stepsNeeded = lround(error * stepsPerRevolution / 360.0f);
+    if (stepsNeeded == 0) {
+        stepsNeeded = (error > 0) ? 1 : -1;
+    }
+
+    #if DEBUG_MODE
+    Serial.print("[FF] Move ");
+    Serial.print(pidIteration + 1);
+    Serial.print(": Angle=");
+    Serial.print(currentAngle, 2);
+    Serial.print("° Err=");
+    Serial.print(error, 2);
+    Serial.print("° → ");
+    Serial.print(stepsNeeded);
+    Serial.println(" steps");
+    #endif
+
+    lastMoveStats.iterations++;
+    lastMoveStats.stepsIssued += abs(startMotorMove(stepsNeeded));
+    motionState = (pidIteration == 0) ? MotionState::ACCELERATING : MotionState::CORRECTING;
+}
+
+long FilterWheelController::startMotorMove(long steps) {
+    steps = applyBacklashCompensation(steps);
+    if (steps != 0) {
+        lastMoveDirection = (steps > 0) ? 1 : -1;
+        // Travel coarse where the driver has such a mode, approach fine
+        long approachSteps = lround(FINE_APPROACH_ANGLE * stepsPerRevolution / 360.0f);
+        stepGenerator->moveCoarse(steps, (uint32_t)approachSteps);
+    }
+    lastStepSpeed = 0.0f;
+    return steps;
+}
+
+void FilterWheelController::startStepLossMonitor(float currentAngle) {
+    slipLastAngle = currentAngle;
+    slipWheelTravel = 0.0f;
+    slipStartSteps = motorDriver->getCurrentPosition();
+    lastSlipCheck = Clock::system().millis();
+}
+
+void FilterWheelController::updateStepLossMonitor() {
+    unsigned long now = Clock::system().millis();
+    if (!stepLossDetectionEnabled || now - lastSlipCheck < STEP_LOSS_CHECK_INTERVAL) {
+        return;
+    }
+    lastSlipCheck = now;
+
+    float currentAngle = readEncoderAngle();
+    if (currentAngle < 0) {
+        return;  // Skip the sample, the settled read still catches a slip
+    }
+
+    // Summed in short hops, so travel over half a turn does not wrap
+    slipWheelTravel += calculateAngularError(slipLastAngle, currentAngle);
+    slipLastAngle = currentAngle;
+
+    // The motor crosses the gear play before the wheel follows
+    float degreesPerStep = 360.0f / stepsPerRevolution;
+    float lag = (motorDriver->getCurrentPosition() - slipStartSteps) * degreesPerStep - slipWheelTravel;
+    float play = backlashSteps * degreesPerStep;
+    if (abs(lag) <= play + STEP_LOSS_THRESHOLD) {
+        return;
+    }
+
+    long lostSteps = lround((lag > 0 ? lag - play : lag + play) / degreesPerStep);
+    lastMoveStats.stepsLost += abs(lostSteps);
+
+    #if DEBUG_MODE
+    Serial.print("[SLIP] Wheel ");
+    Serial.print(lag, 2);
+    Serial.print("° behind the motor, ");
+    Serial.print(lostSteps);
+    Serial.println(" steps lost");
+    #endif
+
+    if (abs(slipWheelTravel) < STEP_LOSS_THRESHOLD) {
+        // The wheel did not follow at all: jammed, stop instead of grinding on
+        stopMotion();
+        setError(1);
+        emitMoveEvent(MoveEvent::STALLED);
+        return;
+    }
+    emitMoveEvent(MoveEvent::SLIPPED);
+
+    // A slipping rotor does not catch up with a running profile: restart
+    // the rest of the segment from standstill, lengthened by what was lost.
+    // Tracking replans to the encoder instead, which already includes the
+    // lost steps.
+    long remaining;
+    if (encoderControlMode == EncoderControlMode::TRACKING) {
+        float error = calculateAngularError(currentAngle, motionTargetAngle) + segmentErrorOffset;
+        remaining = lround(error * stepsPerRevolution / 360.0f);
+    } else {
+        remaining = stepGenerator->getTargetPosition() - motorDriver->getCurrentPosition() + lostSteps;
+    }
+    stepGenerator->abort();
+    startMotorMove(remaining);
+    if (encoderControlMode != EncoderControlMode::TRACKING) {
+        lastMoveStats.stepsIssued += abs(lostSteps);  // Tracking counts driver travel instead
+    }
+    startStepLossMonitor(currentAngle);
+}
+
+void FilterWheelController::updateTrackingTarget() {
+    unsigned long now = Clock::system().millis();
+    if (now - lastTrackingSample < ANGLE_TRACKING_INTERVAL) {
+        return;
+    }
+    lastTrackingSample = now;
+
+    float currentAngle = readEncoderAngle();
+    if (currentAngle < 0) {
+        return;  // Keep the current target, the final read will catch it
+    }
+
+    // Until the wheel itself moves, the error still includes the backlash
+    // being taken up; retargeting then would overshoot by that amount
+    if (abs(calculateAngularError(trackingStartAngle, currentAngle)) < ANGLE_TRACKING_ENGAGE_ANGLE) {
+        return;
+    }
+
+    float error = calculateAngularError(currentAngle, motionTargetAngle) + segmentErrorOffset;
+    float stepsPerDegree = stepsPerRevolution / 360.0f;
+    long newTarget = motorDriver->getCurrentPosition() + lround(error * stepsPerDegree);
+
+    // Ignore encoder noise (two full steps), the planner replans on every moveTo()
+    if (abs(newTarget - stepGenerator->getTargetPosition()) < 2 * motorDriver->getMicrosteps()) {
+        return;
+    }
+
+    // Reversing crosses the gear play like startMotorMove(); hold the target
+    // until the wheel follows again
+    long steps = newTarget - motorDriver->getCurrentPosition();
+    int8_t direction = (steps > 0) ? 1 : -1;
+    if (steps != 0 && direction != lastMoveDirection) {
+        newTarget = motorDriver->getCurrentPosition() + applyBacklashCompensation(steps);
+        lastMoveDirection = direction;
+        trackingStartAngle = currentAngle;
+    }
+    stepGenerator->moveTo(newTarget);
+}
+
+void FilterWheelController::completeMove(bool success) {
     if (success) {
         currentPosition = targetPosition;
 
@@ -227,9 +776,10 @@ bool FilterWheelController::moveToPosition(uint8_t position) {
 
         // Verify position with encoder if available
         if (encoder && encoder->isAvailable()) {
-            float currentAngle = encoder->getAngle();
+            float currentAngle = readEncoderAngle();
             float targetAngle = positionToAngle(currentPosition);
             float error = abs(calculateAngularError(currentAngle, targetAngle));
+            lastMoveStats.finalError = error;
 
             #if DEBUG_MODE
             Serial.print("[moveToPosition] Final verification - Current angle: ");
@@ -248,12 +798,6 @@ bool FilterWheelController::moveToPosition(uint8_t position) {
                 needsCalibration = true;
             }
         }
-
-        // Update display to show ready
-        if (displayManager) {
-            displayManager->showFilterWheelState("READY", currentPosition, numFilters,
-                                                getFilterName(currentPosition).c_str());
-        }
     } else {
         #if DEBUG_MODE
         Serial.println("[moveToPosition] ERROR: Movement failed");
@@ -261,7 +805,38 @@ bool FilterWheelController::moveToPosition(uint8_t position) {
         setError(1); // Movement failed
     }
 
-    return success;
+    // Remember which side of the gear play the wheel rests on
+    if (stepGenerator && stepGenerator->getProfile().totalSteps > 0) {
+        lastMoveDirection = stepGenerator->getProfile().direction;
+    }
+
+    // Power down in stages from update(), or at once after a failure
+    if (motorDriver) {
+        if (success) {
+            motorDisablePending = true;
+            powerStateSince = Clock::system().millis();
+        } else {
+            powerDownMotor();
+        }
+    }
+
+    lastMoveStats.usedEncoder = motionUsesEncoder && success;
+    lastMoveStats.success = success;
+    lastMoveStats.durationMs = Clock::system().millis() - movementStartTime;
+
+    isMoving = false;
+    motionState = MotionState::DONE;
+    emitMoveEvent(success ? MoveEvent::COMPLETED : MoveEvent::FAILED);
+
+    // Update display to show ready (unless the next queued move follows at once)
+    if (displayManager && success && !queueNextPrepared) {
+        displayManager->showFilterWheelState("READY", currentPosition, numFilters,
+                                            getFilterName(currentPosition).c_str());
+    }
+}
+
+const FilterWheelController::MoveStats& FilterWheelController::getLastMoveStats() const {
+    return lastMoveStats;
 }
 
 uint8_t FilterWheelController::getCurrentPosition() const {
@@ -277,40 +852,237 @@ bool FilterWheelController::isMotorMoving() const {
 }
 
 void FilterWheelController::emergencyStop() {
+    bool wasMoving = isMoving;
+    stopMotion();
+    clearMoveQueue();
+    if (wasMoving) {
+        emitMoveEvent(MoveEvent::FAILED);
+    }
+}
+
+void FilterWheelController::stopMotion() {
+    if (stepGenerator) {
+        stepGenerator->abort();
+    }
     if (motorDriver) {
+        if (isMoving && motionState == MotionState::CALIBRATING &&
+            calibrationRoutine == CalibrationRoutine::HOMING) {
+            motorDriver->endStallDetection();
+        }
         motorDriver->emergencyStop();
+        powerDownMotor();
     }
+    if (isMoving) {
+        lastMoveStats.success = false;
+        lastMoveStats.durationMs = Clock::system().millis() - movementStartTime;
+        motionState = MotionState::IDLE;
+    }
+    pendingApproachSteps = 0;
     isMoving = false;
     clearError();
 }
 
-void FilterWheelController::setCurrentPosition(uint8_t position) {
-    if (isValidPosition(position)) {
-        currentPosition = position;
-        targetPosition = position;
+void FilterWheelController::emitMoveEvent(MoveEvent event) {
+    // Skip building the line when nobody listens
+    if (!commandProcessor || !commandProcessor->areEventsEnabled()) {
+        return;
+    }
 
-        if (motorDriver) {
-            motorDriver->setCurrentPosition(0); // Reset step counter
-        }
+    String line;
+    switch (event) {
+        case MoveEvent::STARTED:
+            line = "MOVE_START,FROM=" + String(lastMoveStats.fromPosition);
+            line += ",TO=" + String(lastMoveStats.toPosition);
+            break;
+        case MoveEvent::COMPLETED:
+            line = "MOVE_DONE,POS=" + String(currentPosition);
+            line += ",ERROR=" + String(lastMoveStats.finalError, 2);
+            line += ",TIME=" + String(lastMoveStats.durationMs);
+            break;
+        case MoveEvent::SLIPPED:
+            line = "MOVE_SLIP,POS=" + String(currentPosition);
+            line += ",TARGET=" + String(lastMoveStats.toPosition);
+            line += ",LOST=" + String(lastMoveStats.stepsLost);
+            line += ",TIME=" + String(Clock::system().millis() - movementStartTime);
+            break;
+        case MoveEvent::FAILED:
+        case MoveEvent::STALLED:
+            line = (event == MoveEvent::FAILED) ? "MOVE_FAIL" : "MOVE_STALL";
+            line += ",POS=" + String(currentPosition);
+            line += ",TARGET=" + String(lastMoveStats.toPosition);
+            line += ",CODE=" + String(errorCode);
+            line += ",TIME=" + String(lastMoveStats.durationMs);
+            break;
+    }
+    commandProcessor->sendEvent(line);
+}
 
-        if (configManager) {
-            configManager->saveCurrentPosition(position);
+bool FilterWheelController::queueMoves(const uint8_t* positions, const uint32_t* dwellMs,
+                                       uint8_t count) {
+    if (isMoving || count < 1 || count > MAX_QUEUED_MOVES) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (!isValidPosition(positions[i])) {
+            return false;
         }
     }
-}
 
-void FilterWheelController::calibrateHome() {
-    #if DEBUG_MODE
-    Serial.println("========================================");
-    Serial.println("[CALIBRATION] Starting calibration process");
-    Serial.println("========================================");
-    #endif
+    for (uint8_t i = 0; i < count; i++) {
+        moveQueue[i].position = positions[i];
+        moveQueue[i].dwellMs = dwellMs ? dwellMs[i] : 0;
+    }
+    queueLength = count;
+    queueIndex = 0;
+    queueCompleted = 0;
+    queueMoveRunning = false;
+    queueNextPrepared = false;
+    queueState = QueueState::RUNNING;
+    return true;
+}
 
-    setCurrentPosition(1);
-    isCalibrated = true;
+void FilterWheelController::clearMoveQueue() {
+    queueLength = 0;
+    queueIndex = 0;
+    queueCompleted = 0;
+    queueMoveRunning = false;
+    queueNextPrepared = false;
+    queueState = QueueState::IDLE;
+}
 
-    if (configManager) {
-        configManager->setCalibrated(true);
+FilterWheelController::QueueStatus FilterWheelController::getQueueStatus() const {
+    QueueStatus status;
+    status.state = queueState;
+    status.completed = queueCompleted;
+    status.total = queueLength;
+    status.position = 0;
+    status.dwellRemainingMs = 0;
+
+    if (queueState == QueueState::DWELLING || queueMoveRunning) {
+        const QueuedMove& entry = moveQueue[queueIndex - 1];
+        status.position = entry.position;
+        if (queueState == QueueState::DWELLING) {
+            unsigned long elapsed = Clock::system().millis() - dwellStartTime;
+            status.dwellRemainingMs = (elapsed < entry.dwellMs) ? entry.dwellMs - elapsed : 0;
+        }
+    } else if (queueState == QueueState::RUNNING && queueIndex < queueLength) {
+        status.position = moveQueue[queueIndex].position;
+    }
+    return status;
+}
+
+const char* FilterWheelController::getQueueStateName(QueueState state) {
+    switch (state) {
+        case QueueState::IDLE:     return "IDLE";
+        case QueueState::RUNNING:  return "RUNNING";
+        case QueueState::DWELLING: return "DWELLING";
+        case QueueState::DONE:     return "DONE";
+        case QueueState::FAILED:   return "FAILED";
+    }
+    return "UNKNOWN";
+}
+
+void FilterWheelController::updateMoveQueue() {
+    if (queueState != QueueState::RUNNING && queueState != QueueState::DWELLING) {
+        return;
+    }
+
+    if (isMoving) {
+        // Plan the next move while this one settles
+        if (queueMoveRunning && !queueNextPrepared && motionState == MotionState::SETTLING) {
+            prepareQueuedMove();
+        }
+        return;
+    }
+
+    unsigned long now = Clock::system().millis();
+
+    if (queueMoveRunning) {
+        queueMoveRunning = false;
+        if (!lastMoveStats.success) {
+            #if DEBUG_MODE
+            Serial.print("[QUEUE] Move to position ");
+            Serial.print(lastMoveStats.toPosition);
+            Serial.println(" failed, dropping the queue");
+            #endif
+            queueNextPrepared = false;
+            queueState = QueueState::FAILED;
+            return;
+        }
+        dwellStartTime = now;
+        queueState = QueueState::DWELLING;
+    }
+
+    if (queueState == QueueState::DWELLING) {
+        if (now - dwellStartTime < moveQueue[queueIndex - 1].dwellMs) {
+            return;
+        }
+        queueCompleted++;
+        queueState = QueueState::RUNNING;
+    }
+
+    if (queueIndex >= queueLength) {
+        queueState = QueueState::DONE;
+        return;
+    }
+
+    uint8_t position = moveQueue[queueIndex++].position;
+    bool started = moveToPosition(position);
+    queueNextPrepared = false;
+    if (!started) {
+        queueState = QueueState::FAILED;
+        return;
+    }
+    queueMoveRunning = true;
+}
+
+void FilterWheelController::prepareQueuedMove() {
+    // Only back-to-back entries: during a dwell the display shows the filter in use
+    if (queueIndex >= queueLength || moveQueue[queueIndex - 1].dwellMs > 0) {
+        return;
+    }
+    queueNextPrepared = true;
+
+    // Ramp table for the next trajectory (rebuilt only if a setting changed)
+    if (stepGenerator && motorDriver) {
+        stepGenerator->configurePlanner();
+    }
+
+    // Draw the next move now; the completion and start redraws are skipped
+    if (displayManager) {
+        uint8_t next = moveQueue[queueIndex].position;
+        displayManager->showFilterWheelState("MOVING", next, numFilters,
+                                            getFilterName(next).c_str(), true);
+    }
+}
+
+void FilterWheelController::setCurrentPosition(uint8_t position) {
+    if (isValidPosition(position)) {
+        currentPosition = position;
+        targetPosition = position;
+
+        if (motorDriver) {
+            motorDriver->setCurrentPosition(0); // Reset step counter
+        }
+
+        if (configManager) {
+            configManager->saveCurrentPosition(position);
+        }
+    }
+}
+
+void FilterWheelController::calibrateHome() {
+    #if DEBUG_MODE
+    Serial.println("========================================");
+    Serial.println("[CALIBRATION] Starting calibration process");
+    Serial.println("========================================");
+    #endif
+
+    setCurrentPosition(1);
+    isCalibrated = true;
+
+    if (configManager) {
+        configManager->setCalibrated(true);
     }
 
     // If encoder is available, calibrate angle offset so position 1 = 0°
@@ -323,7 +1095,7 @@ void FilterWheelController::calibrateHome() {
         const int SAMPLES = 5;
 
         for (int i = 0; i < SAMPLES; i++) {
-            float reading = encoder->getAngle();
+            float reading = readEncoderAngle();
             angleSum += reading;
             #if DEBUG_MODE
             Serial.print("[CALIBRATION] Sample ");
@@ -332,7 +1104,7 @@ void FilterWheelController::calibrateHome() {
             Serial.print(reading, 2);
             Serial.println("°");
             #endif
-            delay(50);
+            Clock::system().delay(50);
         }
 
         float averageAngle = angleSum / SAMPLES;
@@ -390,57 +1162,571 @@ void FilterWheelController::calibrateHome() {
             Serial.print(verifyEEPROM, 2);
             Serial.println("°");
 
-            if (abs(verifyEEPROM - rawAngle) > 0.1f) {
-                Serial.println("[CALIBRATION] ERROR: EEPROM did not save correctly!");
-            }
-            #endif
-        } else {
-            #if DEBUG_MODE
-            Serial.println("[CALIBRATION] ERROR: ConfigManager is NULL!");
-            #endif
-        }
+            if (abs(verifyEEPROM - rawAngle) > 0.1f) {
+                Serial.println("[CALIBRATION] ERROR: EEPROM did not save correctly!");
+            }
+            #endif
+        } else {
+            #if DEBUG_MODE
+            Serial.println("[CALIBRATION] ERROR: ConfigManager is NULL!");
+            #endif
+        }
+
+        #if DEBUG_MODE
+        // Verify calibration with multiple readings
+        Serial.println("[CALIBRATION] Verifying calibration...");
+        Clock::system().delay(100);
+
+        float verifySum = 0;
+        for (int i = 0; i < 3; i++) {
+            float reading = readEncoderAngle();
+            verifySum += reading;
+            Serial.print("[CALIBRATION] Verify sample ");
+            Serial.print(i + 1);
+            Serial.print(": ");
+            Serial.print(reading, 2);
+            Serial.println("°");
+            Clock::system().delay(50);
+        }
+
+        float finalAngle = verifySum / 3;
+        Serial.print("[CALIBRATION] Final verified angle: ");
+        Serial.print(finalAngle, 2);
+        Serial.println("° (should be close to 0°)");
+
+        if (abs(finalAngle) > 2.0f) {
+            Serial.println("[CALIBRATION] WARNING: Calibration error > 2°");
+            Serial.println("[CALIBRATION] This may indicate encoder noise or movement during calibration");
+        } else {
+            Serial.println("[CALIBRATION] ✓ Calibration successful!");
+        }
+        #endif
+    }
+
+    if (displayManager) {
+        displayManager->showFilterWheelState("CALIBRATED", currentPosition, numFilters,
+                                            getFilterName(currentPosition).c_str());
+    }
+
+    #if DEBUG_MODE
+    Serial.println("========================================");
+    Serial.println("[CALIBRATION] Calibration complete!");
+    Serial.println("========================================");
+    #endif
+}
+
+bool FilterWheelController::startRevolutionCalibration() {
+    if (isMoving || !motorDriver || !stepGenerator || !encoder || !encoder->isAvailable()) {
+        return false;
+    }
+
+    float startAngle = readEncoderAngle();
+    if (startAngle < 0) {
+        return false;
+    }
+
+    float angles[RevolutionCalibration::MAX_POSITIONS];
+    for (uint8_t i = 0; i < numFilters; i++) {
+        angles[i] = positionToAngle(i + 1);
+    }
+
+    #if DEBUG_MODE
+    Serial.print("[CALSTEPS] Starting revolution calibration at ");
+    Serial.print(startAngle, 2);
+    Serial.println("°");
+    #endif
+
+    revolutionCalibration.begin(startAngle, motorDriver->getCurrentPosition(), angles,
+                                numFilters, STEP_TABLE_LEAD_ANGLE);
+    calibrationRoutine = CalibrationRoutine::REVOLUTION;
+    calibrationReturnPosition = currentPosition;
+
+    isMoving = true;
+    movementStartTime = Clock::system().millis();
+
+    if (displayManager) {
+        displayManager->showFilterWheelState("CAL STEPS", currentPosition, numFilters,
+                                            getFilterName(currentPosition).c_str(), true);
+    }
+
+    // Stopped from updateRevolutionCalibration() once a full turn was seen
+    powerUpMotor();
+    stepGenerator->move((long)STEP_TABLE_MAX_STEPS * motorDriver->getMicrosteps());
+    motionState = MotionState::CALIBRATING;
+    return true;
+}
+
+void FilterWheelController::updateRevolutionCalibration() {
+    bool running = stepGenerator->run();
+
+    if (!revolutionCalibration.isComplete()) {
+        float angle = readEncoderAngle();
+        if (angle >= 0 && revolutionCalibration.addSample(angle, motorDriver->getCurrentPosition())) {
+            stepGenerator->stop();
+        }
+    }
+
+    if (!running) {
+        finishRevolutionCalibration();
+    }
+}
+
+void FilterWheelController::finishRevolutionCalibration() {
+    long measured = revolutionCalibration.getStepsPerRevolution();
+    bool success = measured > 0 && measured <= 0xFFFF &&
+                   revolutionCalibration.getPositionSteps(positionSteps);
+
+    if (success) {
+        stepsPerRevolution = measured;
+        stepTableCount = numFilters;
+        if (configManager) {
+            configManager->saveStepTable((uint16_t)measured, stepTableCount, positionSteps);
+        }
+
+        #if DEBUG_MODE
+        Serial.print("[CALSTEPS] Steps/rev: ");
+        Serial.println(measured);
+        for (uint8_t i = 0; i < stepTableCount; i++) {
+            Serial.print("[CALSTEPS] Position ");
+            Serial.print(i + 1);
+            Serial.print(": ");
+            Serial.println(positionSteps[i]);
+        }
+        #endif
+    } else {
+        #if DEBUG_MODE
+        Serial.print("[CALSTEPS] ERROR: No full revolution seen, travel ");
+        Serial.print(revolutionCalibration.getTravel(), 1);
+        Serial.println("°");
+        #endif
+        setError(1);
+    }
+
+    lastMoveDirection = 1;
+    isMoving = false;
+    motionState = MotionState::DONE;
+
+    // The wheel stopped past its start: go back to the filter it was on
+    if (success) {
+        moveToPosition(calibrationReturnPosition);
+    } else {
+        powerDownMotor();
+    }
+}
+
+bool FilterWheelController::startBacklashCalibration() {
+    if (isMoving || !motorDriver || !stepGenerator || !encoder || !encoder->isAvailable()) {
+        return false;
+    }
+
+    #if DEBUG_MODE
+    Serial.println("[CALBL] Starting backlash calibration");
+    #endif
+
+    calibrationRoutine = CalibrationRoutine::BACKLASH;
+    calibrationReturnPosition = currentPosition;
+    backlashProbeDirection = 0;
+    backlashProbeSteps = 0;
+    backlashMeasurements = 0;
+
+    isMoving = true;
+    movementStartTime = Clock::system().millis();
+
+    if (displayManager) {
+        displayManager->showFilterWheelState("CAL BKLSH", currentPosition, numFilters,
+                                            getFilterName(currentPosition).c_str(), true);
+    }
+
+    // Take up the play forward; probing starts once this has settled
+    powerUpMotor();
+    stepGenerator->move((long)BACKLASH_CAL_PRELOAD_STEPS * motorDriver->getMicrosteps());
+    lastMoveDirection = 1;
+    settleStartTime = Clock::system().millis();
+    motionState = MotionState::CALIBRATING;
+    return true;
+}
+
+void FilterWheelController::updateBacklashCalibration() {
+    unsigned long now = Clock::system().millis();
+    if (stepGenerator->run()) {
+        settleStartTime = now;
+        return;
+    }
+    if (now - settleStartTime < BACKLASH_CAL_SETTLE_TIME) {
+        return;
+    }
+
+    float angle = readEncoderAngle();
+    if (angle < 0) {
+        finishBacklashCalibration(false);
+        return;
+    }
+
+    if (backlashProbeDirection != 0) {
+        float moved = calculateAngularError(backlashReferenceAngle, angle) * backlashProbeDirection;
+        if (moved < BACKLASH_CAL_DETECT_ANGLE) {
+            // Probe one full step at a time, counted in driver steps
+            int probeSteps = motorDriver->getMicrosteps();
+            if (backlashProbeSteps >= BACKLASH_CAL_MAX_STEPS * probeSteps) {
+                finishBacklashCalibration(false);
+                return;
+            }
+            stepGenerator->move(backlashProbeDirection * probeSteps);
+            backlashProbeSteps += probeSteps;
+            settleStartTime = now;
+            return;
+        }
+
+        // The last few steps turned the wheel by the detection angle, the rest was play
+        int play = backlashProbeSteps - (int)lround(BACKLASH_CAL_DETECT_ANGLE * stepsPerRevolution / 360.0f);
+        backlashMeasured[backlashMeasurements++] = (play > 0) ? play : 0;
+
+        #if DEBUG_MODE
+        Serial.print("[CALBL] Reversal to ");
+        Serial.print(backlashProbeDirection > 0 ? "forward" : "backward");
+        Serial.print(": ");
+        Serial.print(backlashProbeSteps);
+        Serial.print(" steps until the wheel moved, play ");
+        Serial.println(backlashMeasured[backlashMeasurements - 1]);
+        #endif
+
+        if (backlashMeasurements == 2) {
+            finishBacklashCalibration(true);
+            return;
+        }
+    }
+
+    // Preload done or a reversal measured: probe the other way from here
+    backlashProbeDirection = (backlashProbeDirection < 0) ? 1 : -1;
+    backlashReferenceAngle = angle;
+    backlashProbeSteps = motorDriver->getMicrosteps();
+    lastMoveDirection = backlashProbeDirection;
+    stepGenerator->move(backlashProbeDirection * backlashProbeSteps);
+    settleStartTime = now;
+}
+
+void FilterWheelController::finishBacklashCalibration(bool success) {
+    if (success) {
+        setBacklashSteps((backlashMeasured[0] + backlashMeasured[1] + 1) / 2);
+
+        #if DEBUG_MODE
+        Serial.print("[CALBL] Backlash: ");
+        Serial.print(backlashSteps);
+        Serial.println(" steps");
+        #endif
+    } else {
+        #if DEBUG_MODE
+        Serial.println("[CALBL] ERROR: Wheel did not move after reversing");
+        #endif
+        setError(1);
+    }
+
+    isMoving = false;
+    motionState = MotionState::DONE;
+
+    // Return to the filter, approaching with the new compensation
+    if (success) {
+        moveToPosition(calibrationReturnPosition);
+    } else {
+        powerDownMotor();
+    }
+}
+
+bool FilterWheelController::startPidAutotune() {
+    if (isMoving || !motorDriver || !stepGenerator || !encoder || !encoder->isAvailable()) {
+        return false;
+    }
+
+    float startAngle = readEncoderAngle();
+    if (startAngle < 0) {
+        return false;
+    }
+
+    long relaySteps = lround(PID_AUTOTUNE_RELAY_ANGLE * stepsPerRevolution / 360.0f);
+
+    #if DEBUG_MODE
+    Serial.print("[PIDTUNE] Starting relay autotune at ");
+    Serial.print(startAngle, 2);
+    Serial.print("°, relay ");
+    Serial.print(relaySteps);
+    Serial.println(" steps");
+    #endif
+
+    relayAutotuner.begin(relaySteps, PID_AUTOTUNE_HYSTERESIS, PID_AUTOTUNE_CYCLES);
+    autotuneSetpoint = startAngle;
+    calibrationRoutine = CalibrationRoutine::PID_AUTOTUNE;
+    calibrationReturnPosition = currentPosition;
+
+    isMoving = true;
+    movementStartTime = Clock::system().millis();
+
+    if (displayManager) {
+        displayManager->showFilterWheelState("PID TUNE", currentPosition, numFilters,
+                                            getFilterName(currentPosition).c_str(), true);
+    }
+
+    // First relay move; the rest follow each settled read
+    powerUpMotor();
+    startMotorMove(relayAutotuner.update(0.0f));
+    settleStartTime = Clock::system().millis();
+    motionState = MotionState::CALIBRATING;
+    return true;
+}
+
+void FilterWheelController::updatePidAutotune() {
+    unsigned long now = Clock::system().millis();
+    if (stepGenerator->run()) {
+        settleStartTime = now;
+        return;
+    }
+    if (now - settleStartTime < ANGLE_PID_SETTLING_TIME) {
+        return;
+    }
+
+    float angle = readEncoderAngle();
+    if (angle < 0) {
+        finishPidAutotune(false);
+        return;
+    }
+
+    long steps = relayAutotuner.update(calculateAngularError(angle, autotuneSetpoint));
+    if (relayAutotuner.isComplete()) {
+        finishPidAutotune(true);
+        return;
+    }
+    if (relayAutotuner.getIterations() >= PID_AUTOTUNE_MAX_ITERATIONS) {
+        finishPidAutotune(false);
+        return;
+    }
+
+    startMotorMove(steps);
+    settleStartTime = now;
+}
+
+void FilterWheelController::finishPidAutotune(bool success) {
+    float kp = success ? relayAutotuner.getProportionalGain() : 0.0f;
+
+    if (kp > 0.0f) {
+        // Integral and derivative keep their share of the default tuning
+        setPidGains(kp, kp * ANGLE_PID_KI / ANGLE_PID_KP, kp * ANGLE_PID_KD / ANGLE_PID_KP);
+
+        #if DEBUG_MODE
+        Serial.print("[PIDTUNE] Ku=");
+        Serial.print(relayAutotuner.getUltimateGain(), 2);
+        Serial.print(" Tu=");
+        Serial.print(relayAutotuner.getUltimatePeriod(), 1);
+        Serial.print(" amplitude=");
+        Serial.print(relayAutotuner.getAmplitude(), 2);
+        Serial.print("° -> Kp=");
+        Serial.print(pidKp, 3);
+        Serial.print(" Ki=");
+        Serial.print(pidKi, 3);
+        Serial.print(" Kd=");
+        Serial.println(pidKd, 3);
+        #endif
+    } else {
+        #if DEBUG_MODE
+        Serial.println("[PIDTUNE] ERROR: No steady oscillation");
+        #endif
+        success = false;
+        setError(1);
+    }
+
+    isMoving = false;
+    motionState = MotionState::DONE;
+
+    // Return to the filter with the new gains
+    if (success) {
+        moveToPosition(calibrationReturnPosition);
+    } else {
+        powerDownMotor();
+    }
+}
+
+bool FilterWheelController::startSensorlessHoming() {
+    if (isMoving || !motorDriver || !stepGenerator || !motorDriver->supportsStallDetection()) {
+        return false;
+    }
+    if (!motorDriver->beginStallDetection()) {
+        return false;
+    }
+
+    #if DEBUG_MODE
+    Serial.println("[HOME] Seeking the hard stop");
+    #endif
+
+    calibrationRoutine = CalibrationRoutine::HOMING;
+    calibrationReturnPosition = currentPosition;
+    homingPhase = HomingPhase::SEEKING;
+    homingStartSteps = motorDriver->getCurrentPosition();
+    lastStallSample = 0;
+
+    isMoving = true;
+    movementStartTime = Clock::system().millis();
+
+    if (displayManager) {
+        displayManager->showFilterWheelState("HOMING", currentPosition, numFilters,
+                                            getFilterName(currentPosition).c_str(), true);
+    }
+
+    // Stopped from updateSensorlessHoming() once the driver reports a stall
+    powerUpMotor();
+    stepGenerator->move(HOMING_DIRECTION * lround(HOMING_MAX_ANGLE * stepsPerRevolution / 360.0f));
+    lastMoveDirection = HOMING_DIRECTION;
+    motionState = MotionState::CALIBRATING;
+    return true;
+}
+
+void FilterWheelController::updateSensorlessHoming() {
+    unsigned long now = Clock::system().millis();
+    bool running = stepGenerator->run();
+
+    switch (homingPhase) {
+        case HomingPhase::SEEKING: {
+            // Readings only count at speed: not on the ramps at either end
+            long ignoreSteps = lround(HOMING_IGNORE_ANGLE * stepsPerRevolution / 360.0f);
+            long position = motorDriver->getCurrentPosition();
+            bool valid = abs(position - homingStartSteps) >= ignoreSteps &&
+                         abs(stepGenerator->getTargetPosition() - position) >= ignoreSteps;
+            if (valid && now - lastStallSample >= HOMING_SAMPLE_INTERVAL) {
+                lastStallSample = now;
+                if (motorDriver->isStallDetected()) {
+                    // The wheel is against the stop, further steps would be lost
+                    stepGenerator->abort();
+                    motorDriver->endStallDetection();
+                    homingPhase = HomingPhase::AT_STOP;
+                    settleStartTime = now;
+
+                    #if DEBUG_MODE
+                    Serial.print("[HOME] Stall after ");
+                    Serial.print(abs(motorDriver->getCurrentPosition() - homingStartSteps));
+                    Serial.println(" steps");
+                    #endif
+                    return;
+                }
+            }
+            if (!running) {
+                motorDriver->endStallDetection();
+                finishSensorlessHoming(false);
+            }
+            break;
+        }
+
+        case HomingPhase::AT_STOP:
+            if (now - settleStartTime >= HOMING_SETTLE_TIME) {
+                // Away from the stop to filter 1, taking up the play on the reversal
+                startMotorMove(-HOMING_DIRECTION * lround(HOMING_ORIGIN_ANGLE * stepsPerRevolution / 360.0f));
+                homingPhase = HomingPhase::BACKING_OFF;
+            }
+            break;
+
+        case HomingPhase::BACKING_OFF:
+            if (!running) {
+                finishSensorlessHoming(true);
+            }
+            break;
+    }
+}
+
+void FilterWheelController::finishSensorlessHoming(bool success) {
+    if (success) {
+        homedToStop = true;
+        setCurrentPosition(1);
+        isCalibrated = true;
+        if (configManager) {
+            configManager->setCalibrated(true);
+        }
+
+        #if DEBUG_MODE
+        Serial.println("[HOME] Origin set at filter 1");
+        #endif
+    } else {
+        #if DEBUG_MODE
+        Serial.println("[HOME] ERROR: No stall detected");
+        #endif
+        setError(1);
+    }
+
+    isMoving = false;
+    motionState = MotionState::DONE;
+
+    // Back to the filter selected before homing, now from a known origin
+    if (success) {
+        moveToPosition(calibrationReturnPosition);
+    } else {
+        powerDownMotor();
+    }
+}
+
+bool FilterWheelController::isHomedToStop() const {
+    return homedToStop;
+}
 
-        #if DEBUG_MODE
-        // Verify calibration with multiple readings
-        Serial.println("[CALIBRATION] Verifying calibration...");
-        delay(100);
+void FilterWheelController::setPidGains(float kp, float ki, float kd) {
+    pidKp = kp;
+    pidKi = ki;
+    pidKd = kd;
+    pidGainsCustom = true;
+    if (configManager) {
+        configManager->savePidGains(kp, ki, kd);
+    }
+}
 
-        float verifySum = 0;
-        for (int i = 0; i < 3; i++) {
-            float reading = encoder->getAngle();
-            verifySum += reading;
-            Serial.print("[CALIBRATION] Verify sample ");
-            Serial.print(i + 1);
-            Serial.print(": ");
-            Serial.print(reading, 2);
-            Serial.println("°");
-            delay(50);
-        }
+void FilterWheelController::getPidGains(float& kp, float& ki, float& kd) const {
+    if (pidGainsCustom) {
+        kp = pidKp;
+        ki = pidKi;
+        kd = pidKd;
+        return;
+    }
 
-        float finalAngle = verifySum / 3;
-        Serial.print("[CALIBRATION] Final verified angle: ");
-        Serial.print(finalAngle, 2);
-        Serial.println("° (should be close to 0°)");
+    // Defaults are in steps per degree of a reference wheel; scale them to this one
+    float gainScale = (float)stepsPerRevolution / ANGLE_PID_REFERENCE_STEPS;
+    kp = ANGLE_PID_KP * gainScale;
+    ki = ANGLE_PID_KI * gainScale;
+    kd = ANGLE_PID_KD * gainScale;
+}
 
-        if (abs(finalAngle) > 2.0f) {
-            Serial.println("[CALIBRATION] WARNING: Calibration error > 2°");
-            Serial.println("[CALIBRATION] This may indicate encoder noise or movement during calibration");
-        } else {
-            Serial.println("[CALIBRATION] ✓ Calibration successful!");
-        }
-        #endif
+bool FilterWheelController::hasCustomPidGains() const {
+    return pidGainsCustom;
+}
+
+void FilterWheelController::resetPidGains() {
+    pidKp = ANGLE_PID_KP;
+    pidKi = ANGLE_PID_KI;
+    pidKd = ANGLE_PID_KD;
+    pidGainsCustom = false;
+    if (configManager) {
+        configManager->clearPidGains();
     }
+}
 
-    if (displayManager) {
-        displayManager->showFilterWheelState("CALIBRATED", currentPosition, numFilters,
-                                            getFilterName(currentPosition).c_str());
+long FilterWheelController::getStepsPerRevolution() const {
+    return stepsPerRevolution;
+}
+
+bool FilterWheelController::hasStepTable() const {
+    return stepTableCount > 0 && stepTableCount == numFilters;
+}
+
+long FilterWheelController::getPositionSteps(uint8_t position) {
+    if (!isValidPosition(position)) {
+        return 0;
     }
+    if (hasStepTable()) {
+        return positionSteps[position - 1];
+    }
+    return lround((positionToAngle(position) - positionToAngle(1)) * stepsPerRevolution / 360.0f);
+}
 
-    #if DEBUG_MODE
-    Serial.println("========================================");
-    Serial.println("[CALIBRATION] Calibration complete!");
-    Serial.println("========================================");
-    #endif
+void FilterWheelController::clearStepTable() {
+    stepTableCount = 0;
+    if (motorDriver) {
+        stepsPerRevolution = motorDriver->getMicrostepsPerRevolution();
+    }
+    if (configManager) {
+        configManager->clearStepTable();
+    }
 }
 
 String FilterWheelController::getFilterName(uint8_t filterIndex) const {
@@ -457,7 +1743,7 @@ String FilterWheelController::getSystemStatus() const {
     status += ",ERROR=" + String(errorCode);
 
     if (encoder && encoder->isAvailable()) {
-        float currentAngle = const_cast<EncoderInterface*>(encoder.get())->getAngle();
+        float currentAngle = readEncoderAngle();
         float targetAngle = const_cast<FilterWheelController*>(this)->positionToAngle(currentPosition);
         float error = const_cast<FilterWheelController*>(this)->calculateAngularError(currentAngle, targetAngle);
 
@@ -484,13 +1770,48 @@ bool FilterWheelController::initializeMotorDriver(MotorDriverType motorType) {
 }
 
 bool FilterWheelController::initializeDisplay() {
+    // One OLED per board, it shows the first wheel
+    if (wheelIndex > 0) {
+        return true;
+    }
     displayManager = make_unique_compat<DisplayManager>(128, 64, &Wire, -1, 5);
     return displayManager->init(0x3C);
 }
 
 bool FilterWheelController::initializeEncoder() {
-    encoder = make_unique_compat<AS5600Encoder>(&Wire);
-    return encoder->init();
+    // Injected encoders (see init overload) take precedence over the AS5600
+    if (!encoder) {
+        // The AS5600 has a fixed I2C address: only one on the bus
+        if (wheelIndex > 0) {
+            return false;
+        }
+        encoder = make_unique_compat<AS5600Encoder>(&Wire);
+    }
+    if (!encoder->init()) {
+        return false;
+    }
+
+    #if ENCODER_SAMPLER_ENABLED
+    // Angle readers take the latest sample instead of reading the bus
+    encoderSampler = make_unique_compat<EncoderSampler>(encoder.get(), ENCODER_SAMPLE_INTERVAL,
+                                                        ENCODER_IDLE_SAMPLE_INTERVAL);
+    encoderSampler->start();
+    #endif
+    return true;
+}
+
+float FilterWheelController::readEncoderAngle() const {
+    EncoderSampler::Sample latest;
+    uint32_t maxAgeMs = isMoving ? ENCODER_SAMPLE_MAX_AGE : ENCODER_IDLE_SAMPLE_MAX_AGE;
+    if (encoderSampler && encoderSampler->getLatest(latest, maxAgeMs * 1000UL)) {
+        // Track each sample once, so repeated readers don't zero the direction
+        if (latest.timestamp != trackedSampleTime) {
+            trackedSampleTime = latest.timestamp;
+            return encoder->processSample(latest.raw);
+        }
+        return encoder->rawToAngle(latest.raw);
+    }
+    return encoder->getAngle();
 }
 
 bool FilterWheelController::initializeCommandSystem() {
@@ -525,6 +1846,7 @@ void FilterWheelController::loadSystemConfiguration() {
         motorDriver->setMaxSpeed(motorConfig.maxSpeed);
         motorDriver->setAcceleration(motorConfig.acceleration);
         motorDriver->setDisableDelay(motorConfig.disableDelay);
+        motorDisableDelay = motorConfig.disableDelay;
         Serial.print("[CONFIG] Motor config loaded - Speed:");
         Serial.print(motorConfig.speed);
         Serial.print(" MaxSpeed:");
@@ -535,6 +1857,42 @@ void FilterWheelController::loadSystemConfiguration() {
         Serial.println(motorConfig.disableDelay);
     }
 
+    // Load learned step table
+    if (configManager->hasStepTable()) {
+        uint16_t spr = configManager->loadStepTable(stepTableCount, positionSteps);
+        if (spr > 0) {
+            stepsPerRevolution = spr;
+            Serial.print("[CONFIG] Step table loaded - Steps/rev:");
+            Serial.println(spr);
+        }
+    }
+
+    // Load backlash configuration
+    if (configManager->hasBacklashConfig()) {
+        auto backlashConfig = configManager->loadBacklashConfig();
+        backlashSteps = backlashConfig.steps;
+        approachDirection = backlashConfig.approachDirection;
+        Serial.print("[CONFIG] Backlash config loaded - Steps:");
+        Serial.print(backlashSteps);
+        Serial.print(" Approach:");
+        Serial.println(approachDirection);
+    }
+
+    // Load angle PID gains
+    if (configManager->hasPidGains()) {
+        auto pidGains = configManager->loadPidGains();
+        pidKp = pidGains.kp;
+        pidKi = pidGains.ki;
+        pidKd = pidGains.kd;
+        pidGainsCustom = true;
+        Serial.print("[CONFIG] PID gains loaded - Kp:");
+        Serial.print(pidKp, 3);
+        Serial.print(" Ki:");
+        Serial.print(pidKi, 3);
+        Serial.print(" Kd:");
+        Serial.println(pidKd, 3);
+    }
+
     // Load encoder configuration
     if (encoder && encoder->isAvailable() && configManager->isCalibrated()) {
         float angleOffset = configManager->loadAngleOffset();
@@ -562,27 +1920,103 @@ void FilterWheelController::loadSystemConfiguration() {
 }
 
 void FilterWheelController::updateMotorMovement() {
-    // Simplified for blocking movement
-
-    // Check if encoder is available for position verification
-    if (encoder && encoder->isAvailable()) {
-        static unsigned long lastCheckTime = 0;
-        unsigned long currentTime = millis();
+    if (!isMoving) {
+        // Idle: periodically verify position with the encoder
+        if (encoder && encoder->isAvailable()) {
+            unsigned long currentTime = Clock::system().millis();
 
-        // Only check position every 5 seconds to avoid spam
-        if (currentTime - lastCheckTime > 5000) {
-            lastCheckTime = currentTime;
+            // Only check position every 5 seconds to avoid spam
+            if (currentTime - lastIdleCheck > 5000) {
+                lastIdleCheck = currentTime;
 
-            float currentAngle = encoder->getAngle();
+                float currentAngle = readEncoderAngle();
 
-            // If we have AS5600, we can verify our position
-            // This helps detect if the motor has slipped or lost steps
-            uint8_t encoderPosition = angleToPosition(currentAngle);
+                // If we have AS5600, we can verify our position
+                // This helps detect if the motor has slipped or lost steps
+                uint8_t encoderPosition = angleToPosition(currentAngle);
 
-            if (encoderPosition != currentPosition && !isMoving && !inCalibrationMode) {
-                needsCalibration = true;
+                if (encoderPosition != currentPosition && !inCalibrationMode) {
+                    needsCalibration = true;
+                }
             }
         }
+        return;
+    }
+
+    switch (motionState) {
+        case MotionState::ENERGIZING:
+            // Coils were off: let the rotor lock into its step first
+            if (Clock::system().millis() - settleStartTime >= MOTOR_ENABLE_SETTLE_TIME) {
+                beginMove();
+            }
+            break;
+
+        case MotionState::ACCELERATING:
+        case MotionState::CRUISING:
+        case MotionState::DECELERATING:
+        case MotionState::CORRECTING:
+            if (motionUsesEncoder) {
+                updateStepLossMonitor();
+                if (!isMoving) {
+                    return;  // Jammed, the move was given up
+                }
+            }
+            if (motionUsesEncoder && encoderControlMode == EncoderControlMode::TRACKING) {
+                updateTrackingTarget();
+            }
+
+            if (stepGenerator->run()) {
+                // Classify the main approach by the speed profile
+                if (motionState != MotionState::CORRECTING) {
+                    float speed = abs(stepGenerator->getCurrentSpeed());
+                    if (speed >= motorDriver->getMaxSpeed() * motorDriver->getMicrosteps() * 0.98f) {
+                        motionState = MotionState::CRUISING;
+                    } else if (speed < lastStepSpeed) {
+                        motionState = MotionState::DECELERATING;
+                    }
+                    lastStepSpeed = speed;
+                }
+                return;
+            }
+
+            // Step target reached
+            if (motionUsesEncoder && encoderControlMode == EncoderControlMode::TRACKING) {
+                lastMoveStats.stepsIssued += abs(motorDriver->getCurrentPosition() - trackingStartSteps);
+                startSettling(ANGLE_TRACKING_SETTLING_TIME);
+            } else if (motionUsesEncoder && encoderControlMode == EncoderControlMode::FEEDFORWARD) {
+                // One full settle replaces the iterative confirmation read
+                startSettling(ANGLE_VERIFY_SETTLING_TIME);
+            } else if (motionUsesEncoder) {
+                startSettling(ANGLE_PID_SETTLING_TIME);
+            } else if (pendingApproachSteps != 0) {
+                // Overshot on purpose: return from the approach side
+                long steps = pendingApproachSteps;
+                pendingApproachSteps = 0;
+                lastMoveStats.stepsIssued += abs(startMotorMove(steps));
+                motionState = MotionState::CORRECTING;
+            } else {
+                completeMove(true);
+            }
+            break;
+
+        case MotionState::SETTLING:
+            if (updateSettleDetection()) {
+                evaluateEncoderPosition();
+            }
+            break;
+
+        case MotionState::CALIBRATING:
+            switch (calibrationRoutine) {
+                case CalibrationRoutine::REVOLUTION:   updateRevolutionCalibration(); break;
+                case CalibrationRoutine::BACKLASH:     updateBacklashCalibration(); break;
+                case CalibrationRoutine::PID_AUTOTUNE: updatePidAutotune(); break;
+                case CalibrationRoutine::HOMING:       updateSensorlessHoming(); break;
+            }
+            break;
+
+        case MotionState::IDLE:
+        case MotionState::DONE:
+            break;
     }
 }
 
@@ -665,205 +2099,6 @@ int8_t FilterWheelController::determineRotationDirection(float currentAngle, flo
     return (error > 0) ? 1 : -1;
 }
 
-bool FilterWheelController::moveToAngleWithFeedback(float targetAngle, float tolerance) {
-    if (!encoder || !encoder->isAvailable()) {
-        #if DEBUG_MODE
-        Serial.println("[PID] ERROR: Encoder not available");
-        #endif
-        return false;
-    }
-
-    if (!motorDriver) {
-        #if DEBUG_MODE
-        Serial.println("[PID] ERROR: Motor driver not initialized");
-        #endif
-        return false;
-    }
-
-    #if DEBUG_MODE
-    Serial.println("========================================");
-    Serial.print("[PID] Starting PID control to ");
-    Serial.print(targetAngle, 2);
-    Serial.print("° (tolerance: ");
-    Serial.print(tolerance, 2);
-    Serial.println("°)");
-    Serial.println("========================================");
-    #endif
-
-    motorDriver->enableMotor();
-
-    // PID Controller variables
-    float integralSum = 0.0f;
-    float previousError = 0.0f;
-    bool success = false;
-    int iteration = 0;
-
-    // Constants for steps conversion
-    const int stepsPerRevolution = 2048; // 28BYJ-48
-    const float stepsPerDegree = stepsPerRevolution / 360.0f;
-
-    while (iteration < ANGLE_CONTROL_MAX_ITERATIONS && !success) {
-        // Read current angle from encoder
-        float currentAngle = encoder->getAngle();
-        if (currentAngle < 0) {
-            #if DEBUG_MODE
-            Serial.println("[PID] ERROR: Failed to read encoder angle");
-            #endif
-            return false;
-        }
-
-        // Calculate error (with wraparound handling)
-        float error = calculateAngularError(currentAngle, targetAngle);
-
-        // Check if we've reached target
-        if (abs(error) <= tolerance) {
-            // Wait for motor to settle completely before confirming
-            delay(200);
-
-            // Re-read angle to verify final position
-            float finalAngle = encoder->getAngle();
-            float finalError = calculateAngularError(finalAngle, targetAngle);
-
-            #if DEBUG_MODE
-            Serial.println("[PID] ✓ TARGET REACHED!");
-            Serial.print("[PID] Final angle: ");
-            Serial.print(finalAngle, 2);
-            Serial.print("° (target: ");
-            Serial.print(targetAngle, 2);
-            Serial.print("°), Final error: ");
-            Serial.print(finalError, 2);
-            Serial.println("°");
-            #endif
-
-            // If error is still within tolerance after settling, accept it
-            if (abs(finalError) <= tolerance) {
-                success = true;
-                break;
-            } else {
-                #if DEBUG_MODE
-                Serial.println("[PID] Warning: Position drifted after settling, continuing...");
-                #endif
-                // Continue PID loop to correct
-            }
-        }
-
-        // ============================================
-        // PID CALCULATION
-        // ============================================
-
-        // Proportional term: directly proportional to error
-        float proportional = ANGLE_PID_KP * error;
-
-        // Integral term: accumulates error over time (anti-windup protection)
-        integralSum += error;
-        if (integralSum > ANGLE_PID_INTEGRAL_MAX) integralSum = ANGLE_PID_INTEGRAL_MAX;
-        if (integralSum < -ANGLE_PID_INTEGRAL_MAX) integralSum = -ANGLE_PID_INTEGRAL_MAX;
-        float integral = ANGLE_PID_KI * integralSum;
-
-        // Derivative term: rate of change of error (dampens oscillation)
-        float derivative = ANGLE_PID_KD * (error - previousError);
-
-        // PID output (in steps)
-        float pidOutput = proportional + integral + derivative;
-
-        // Convert to integer steps
-        int stepsNeeded = (int)pidOutput;
-
-        // Apply output limits (prevent too large/small movements)
-        if (abs(stepsNeeded) > ANGLE_PID_OUTPUT_MAX) {
-            stepsNeeded = (stepsNeeded > 0) ? ANGLE_PID_OUTPUT_MAX : -ANGLE_PID_OUTPUT_MAX;
-        }
-        if (abs(stepsNeeded) < ANGLE_PID_OUTPUT_MIN && abs(error) > tolerance) {
-            stepsNeeded = (stepsNeeded > 0) ? ANGLE_PID_OUTPUT_MIN : -ANGLE_PID_OUTPUT_MIN;
-        }
-
-        // Overshoot prevention: reduce steps when very close to target
-        // This compensates for motor inertia and mechanical lag
-        if (abs(error) < 5.0f) {
-            // When error < 5°, use 70% of calculated steps to prevent overshoot
-            stepsNeeded = (int)(stepsNeeded * 0.7f);
-            if (abs(stepsNeeded) < ANGLE_PID_OUTPUT_MIN && abs(stepsNeeded) > 0) {
-                stepsNeeded = (stepsNeeded > 0) ? ANGLE_PID_OUTPUT_MIN : -ANGLE_PID_OUTPUT_MIN;
-            }
-        }
-
-        // Log PID values
-        #if DEBUG_MODE
-        Serial.print("[PID] Iter ");
-        Serial.print(iteration + 1);
-        Serial.print(": Angle=");
-        Serial.print(currentAngle, 2);
-        Serial.print("° Err=");
-        Serial.print(error, 2);
-        Serial.print("° | P=");
-        Serial.print(proportional, 1);
-        Serial.print(" I=");
-        Serial.print(integral, 1);
-        Serial.print(" D=");
-        Serial.print(derivative, 1);
-        Serial.print(" → ");
-        Serial.print(stepsNeeded);
-        Serial.print(" steps (");
-        Serial.print(abs(stepsNeeded) / stepsPerDegree, 1);
-        Serial.println("°)");
-        #endif
-
-        // Execute movement
-        if (stepsNeeded > 0) {
-            motorDriver->stepForward(abs(stepsNeeded));
-        } else if (stepsNeeded < 0) {
-            motorDriver->stepBackward(abs(stepsNeeded));
-        }
-
-        // Update previous error for derivative calculation
-        previousError = error;
-
-        // Settling time for mechanical stabilization
-        delay(ANGLE_PID_SETTLING_TIME);
-
-        iteration++;
-    }
-
-    if (!success) {
-        #if DEBUG_MODE
-        Serial.println("[PID] ✗ FAILED to reach target");
-        Serial.print("[PID] Final error: ");
-        Serial.print(previousError, 2);
-        Serial.print("° after ");
-        Serial.print(iteration);
-        Serial.println(" iterations");
-        #endif
-
-        // Disable motor even on failure
-        if (motorDriver) {
-            motorDriver->disableMotor();
-            #if DEBUG_MODE
-            Serial.println("[PID] Motor disabled (failed positioning)");
-            #endif
-        }
-
-        setError(1); // Positioning error
-        return false;
-    }
-
-    #if DEBUG_MODE
-    Serial.print("[PID] Success in ");
-    Serial.print(iteration);
-    Serial.println(" iterations");
-    #endif
-
-    // Disable motor after successful positioning
-    if (motorDriver) {
-        delay(MOTOR_DISABLE_DELAY); // Wait before disabling (from config.h)
-        motorDriver->disableMotor();
-        #if DEBUG_MODE
-        Serial.println("[PID] Motor disabled (positioning complete)");
-        #endif
-    }
-
-    return true;
-}
-
 void FilterWheelController::updateDisplay() {
     if (displayManager) {
         // Update display content based on current state
@@ -895,37 +2130,170 @@ void FilterWheelController::updateDisplay() {
 }
 
 void FilterWheelController::updateMotorPowerManagement() {
-    if (motorDisablePending && millis() >= motorDisableTime) {
-        if (motorDriver) {
-            motorDriver->disableMotor();
-        }
-        motorDisablePending = false;
-        motorEnabled = false;
+    if (!motorDisablePending || isMoving || !motorDriver) {
+        return;
+    }
+    unsigned long now = Clock::system().millis();
+
+    switch (motorPowerState) {
+        case MotorPowerState::ACTIVE:
+            // Full current briefly so the rotor settles into its last step
+            // (released at once it can fall back a step)
+            if (now - powerStateSince < motorDisableDelay) {
+                return;
+            }
+            if (MOTOR_HOLD_CURRENT && motorDriver->getCurrent() > 0) {
+                motorDriver->applyCurrent((uint16_t)(motorDriver->getCurrent() * MOTOR_HOLD_MULTIPLIER));
+                motorPowerState = MotorPowerState::HOLD;
+                powerStateSince = now;
+            } else if (AUTO_DISABLE_MOTOR) {
+                powerDownMotor();
+            } else {
+                motorDisablePending = false;
+            }
+            break;
+
+        case MotorPowerState::HOLD:
+            if (!AUTO_DISABLE_MOTOR) {
+                motorDisablePending = false;  // Hold until the next move
+            } else if (now - powerStateSince >= MOTOR_HOLD_TIME) {
+                powerDownMotor();
+            }
+            break;
+
+        case MotorPowerState::OFF:
+            motorDisablePending = false;
+            break;
+    }
+}
+
+bool FilterWheelController::powerUpMotor() {
+    motorDisablePending = false;
+    bool wasOff = !motorDriver->isMotorEnabled();
+
+    if (motorPowerState == MotorPowerState::HOLD) {
+        motorDriver->applyCurrent(motorDriver->getCurrent());
+    }
+    motorDriver->enableMotor();
+    motorPowerState = MotorPowerState::ACTIVE;
+    powerStateSince = Clock::system().millis();
+    return wasOff;
+}
+
+void FilterWheelController::powerDownMotor() {
+    motorDisablePending = false;
+    if (!motorDriver) {
+        return;
+    }
+
+    // Off with the run current restored, the next move powers up at once
+    if (motorPowerState == MotorPowerState::HOLD) {
+        motorDriver->applyCurrent(motorDriver->getCurrent());
+    }
+    motorDriver->disableMotor();
+    motorPowerState = MotorPowerState::OFF;
+    powerStateSince = Clock::system().millis();
+}
+
+void FilterWheelController::beginManualMove() {
+    if (!motorDriver) {
+        return;
+    }
+    if (powerUpMotor()) {
+        Clock::system().delay(MOTOR_ENABLE_SETTLE_TIME);
+    }
+}
+
+void FilterWheelController::endManualMove() {
+    if (!motorDriver) {
+        return;
+    }
+    motorDisablePending = true;
+    powerStateSince = Clock::system().millis();
+}
+
+void FilterWheelController::setMotorPower(bool enabled) {
+    if (!motorDriver) {
+        return;
+    }
+    if (enabled) {
+        powerUpMotor();  // Stays on: no power-down is scheduled
+    } else {
+        powerDownMotor();
+    }
+}
+
+FilterWheelController::MotorPowerState FilterWheelController::getMotorPowerState() const {
+    return motorPowerState;
+}
+
+const char* FilterWheelController::getMotorPowerStateName(MotorPowerState state) {
+    switch (state) {
+        case MotorPowerState::OFF:    return "OFF";
+        case MotorPowerState::ACTIVE: return "ACTIVE";
+        case MotorPowerState::HOLD:   return "HOLD";
     }
+    return "UNKNOWN";
 }
 
-int FilterWheelController::calculateStepsToPosition(uint8_t targetPos) {
-    // SIMPLIFIED: Fallback step-based control (only used when encoder unavailable)
+void FilterWheelController::setMotorDisableDelay(uint16_t delayMs) {
+    motorDisableDelay = delayMs;
+}
+
+uint16_t FilterWheelController::getMotorDisableDelay() const {
+    return motorDisableDelay;
+}
+
+long FilterWheelController::calculateStepsToPosition(uint8_t targetPos) {
+    // Fallback step-based control (only used when encoder unavailable)
     if (targetPos == currentPosition) {
         return 0;
     }
 
-    // Use default steps per revolution - no calibration needed with encoder
-    int stepsPerRevolution = 2048; // Default for 28BYJ-48
-    int stepsPerFilter = stepsPerRevolution / numFilters;
+    // Absolute step offsets of both positions, so rounding does not
+    // accumulate from move to move
+    long currentSteps = getPositionSteps(currentPosition);
+    long targetSteps = getPositionSteps(targetPos);
+
+    // Homed against a hard stop: measure both from the stop, the
+    // difference then never crosses it
+    if (homedToStop) {
+        long stopSteps = HOMING_DIRECTION * lround(HOMING_ORIGIN_ANGLE * stepsPerRevolution / 360.0f);
+        long currentFromStop = ((currentSteps - stopSteps) % stepsPerRevolution + stepsPerRevolution) % stepsPerRevolution;
+        long targetFromStop = ((targetSteps - stopSteps) % stepsPerRevolution + stepsPerRevolution) % stepsPerRevolution;
+        return targetFromStop - currentFromStop;
+    }
 
-    // Simple forward movement calculation
-    int positionDiff;
-    if (targetPos > currentPosition) {
-        positionDiff = targetPos - currentPosition;
-    } else {
-        positionDiff = (numFilters - currentPosition) + targetPos;
+    long forward = ((targetSteps - currentSteps) % stepsPerRevolution + stepsPerRevolution) % stepsPerRevolution;
+    if (!shortestPathEnabled || forward == 0) {
+        return forward;
+    }
+
+    // Compare both directions including the play taken up on a reversal
+    long backward = stepsPerRevolution - forward;
+    long forwardCost = forward + ((lastMoveDirection < 0) ? backlashSteps : 0);
+    long backwardCost = backward + ((lastMoveDirection > 0) ? backlashSteps : 0);
+
+    // Arriving from the wrong side costs the overshoot there and back
+    if (approachDirection != 0) {
+        long overtravel = lround(BACKLASH_APPROACH_OVERTRAVEL * stepsPerRevolution / 360.0f);
+        long penalty = 2 * overtravel + backlashSteps;
+        forwardCost += (approachDirection < 0) ? penalty : 0;
+        backwardCost += (approachDirection > 0) ? penalty : 0;
     }
 
-    return positionDiff * stepsPerFilter;
+    return (backwardCost < forwardCost) ? -backward : forward;
 }
 
-int FilterWheelController::applyBacklashCompensation(int steps) {
+long FilterWheelController::applyBacklashCompensation(long steps) {
+    if (steps == 0 || lastMoveDirection == 0) {
+        return steps;  // Nothing to reverse from (or direction unknown)
+    }
+
+    int8_t direction = (steps > 0) ? 1 : -1;
+    if (direction != lastMoveDirection) {
+        steps += direction * backlashSteps;
+    }
     return steps;
 }
 
@@ -934,9 +2302,15 @@ bool FilterWheelController::isValidPosition(uint8_t position) const {
 }
 
 void FilterWheelController::checkMovementTimeout() {
-    if (isMoving && (millis() - movementStartTime) > 30000) { // 30 second timeout
-        emergencyStop();
+    // Calibration is bounded by STEP_TABLE_MAX_STEPS instead
+    if (motionState == MotionState::CALIBRATING) {
+        return;
+    }
+
+    if (isMoving && (Clock::system().millis() - movementStartTime) > 30000) { // 30 second timeout
+        stopMotion();
         setError(3); // Movement timeout
+        emitMoveEvent(MoveEvent::STALLED);
     }
 }
 
@@ -962,7 +2336,7 @@ bool FilterWheelController::getIsCalibrated() const {
 
 float FilterWheelController::getEncoderAngle() const {
     if (encoder && encoder->isAvailable()) {
-        return encoder->getAngle();
+        return readEncoderAngle();
     }
     return -1.0f;
 }
@@ -996,9 +2370,27 @@ EncoderInterface* FilterWheelController::getEncoder() const {
     return encoder.get();
 }
 
+StepGenerator* FilterWheelController::getStepGenerator() const {
+    return stepGenerator.get();
+}
+
+bool FilterWheelController::setStepTimer(std::unique_ptr<StepTimer> timer) {
+    if (!stepGenerator || isMoving) {
+        return false;
+    }
+
+    if (!stepGenerator->setTimer(timer.get())) {
+        stepGenerator->setTimer(nullptr);
+        stepTimer.reset();
+        return false;
+    }
+    stepTimer = std::move(timer);
+    return true;
+}
+
 // Setters and other methods would be implemented similarly...
 void FilterWheelController::setFilterCount(uint8_t count) {
-    if (count >= 3 && count <= 8) {
+    if (count >= MIN_FILTER_COUNT && count <= MAX_FILTER_COUNT) {
         numFilters = count;
         if (configManager) {
             configManager->saveFilterCount(count);
@@ -1052,7 +2444,7 @@ void FilterWheelController::finishGuidedCalibration() {
 
     // Get current encoder angle
     if (encoder && encoder->isAvailable()) {
-        float currentAngle = encoder->getAngle();
+        float currentAngle = readEncoderAngle();
 
         // This angle should now represent position 1
         // Calculate the offset needed so that position 1 = current angle
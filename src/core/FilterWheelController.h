@@ -7,6 +7,10 @@
 #include "../commands/CommandHandlers.h"
 #include "../config/ConfigManager.h"
 #include "../encoders/EncoderInterface.h"
+#include "../encoders/EncoderSampler.h"
+#include "../motion/StepGenerator.h"
+#include "../motion/RevolutionCalibration.h"
+#include "../motion/RelayAutotuner.h"
 #include <memory>
 
 /**
@@ -14,7 +18,112 @@
  * Orchestrates all system components and provides high-level interface
  */
 class FilterWheelController {
+public:
+    /**
+     * Motion state machine phases (advanced by update())
+     */
+    enum class MotionState : uint8_t {
+        IDLE,           // No move requested since boot
+        ENERGIZING,     // Coils just switched on, rotor settling into its step
+        ACCELERATING,   // Main approach, ramping up
+        CRUISING,       // Main approach, at max speed
+        DECELERATING,   // Main approach, ramping down to the step target
+        CORRECTING,     // Encoder correction move after the main approach
+        SETTLING,       // Waiting for the mechanism to settle before reading the encoder
+        CALIBRATING,    // Revolution, backlash or PID calibration in progress
+        DONE            // Last move finished
+    };
+
+    /**
+     * Encoder control strategy
+     */
+    enum class EncoderControlMode : uint8_t {
+        ITERATIVE,      // Move a PID chunk, settle, read, repeat
+        TRACKING,       // Sample while stepping and retarget on the fly
+        FEEDFORWARD     // Whole error in one calibrated move, then encoder corrections
+    };
+
+    /**
+     * Statistics of the most recent moveToPosition() call
+     */
+    struct MoveStats {
+        uint8_t fromPosition;
+        uint8_t toPosition;
+        bool usedEncoder;           // Encoder control completed the move
+        uint16_t iterations;        // Encoder control iterations
+        long stepsIssued;           // Total steps commanded (absolute)
+        float finalError;           // Encoder angle error after the move (degrees)
+        long stepsLost;             // Slipped steps seen while stepping (re-planned)
+        unsigned long durationMs;   // Time from MP to completion
+        bool success;
+    };
+
+    /**
+     * Move queue progress
+     */
+    enum class QueueState : uint8_t {
+        IDLE,           // No queue loaded
+        RUNNING,        // Moving to a queued position
+        DWELLING,       // At a queued position, waiting out its dwell time
+        DONE,           // Every entry moved to and dwelled at
+        FAILED          // A queued move failed, the remaining entries were dropped
+    };
+
+    struct QueueStatus {
+        QueueState state;
+        uint8_t completed;              // Entries finished (move and dwell)
+        uint8_t total;
+        uint8_t position;               // Position of the current entry (0 = none)
+        unsigned long dwellRemainingMs;
+    };
+
+    static constexpr uint8_t MAX_QUEUED_MOVES = 16;
+
+    /**
+     * Coil power between moves (advanced by update())
+     */
+    enum class MotorPowerState : uint8_t {
+        OFF,            // Coils off, the next move energizes and settles first
+        ACTIVE,         // Full current: moving, or just stopped
+        HOLD            // Reduced current (drivers with current control), moves start at once
+    };
+
 private:
+    /**
+     * Routine run by MotionState::CALIBRATING
+     */
+    enum class CalibrationRoutine : uint8_t {
+        REVOLUTION,     // Steps per revolution and per-position steps
+        BACKLASH,       // Gear play on a direction reversal
+        PID_AUTOTUNE,   // Angle PID gains from relay feedback
+        HOMING          // Hard stop found by the driver's stall detection
+    };
+
+    /**
+     * Sensorless homing progress
+     */
+    enum class HomingPhase : uint8_t {
+        SEEKING,        // Moving towards the stop, polling for a stall
+        AT_STOP,        // Stall seen, waiting for the rotor to settle
+        BACKING_OFF     // Moving from the stop to filter 1
+    };
+
+    struct QueuedMove {
+        uint8_t position;
+        uint32_t dwellMs;
+    };
+
+    /**
+     * Unsolicited move notifications (see CommandProcessor::sendEvent)
+     */
+    enum class MoveEvent : uint8_t {
+        STARTED,
+        COMPLETED,
+        FAILED,         // Positioning error, or aborted by STOP (CODE=0)
+        STALLED,        // No completion within the movement timeout, or jammed
+        SLIPPED         // Steps lost while moving, the rest of the move was re-planned
+    };
+
     // Component instances
     std::unique_ptr<MotorDriver> motorDriver;
     std::unique_ptr<DisplayManager> displayManager;
@@ -22,6 +131,10 @@ private:
     std::unique_ptr<CommandHandlers> commandHandlers;
     std::unique_ptr<ConfigManager> configManager;
     std::unique_ptr<EncoderInterface> encoder;
+    std::unique_ptr<EncoderSampler> encoderSampler; // Must not outlive encoder
+    mutable uint32_t trackedSampleTime;             // Last sample fed to the encoder's movement tracking
+    std::unique_ptr<StepTimer> stepTimer;           // Must outlive stepGenerator
+    std::unique_ptr<StepGenerator> stepGenerator;
 
     // System state
     uint8_t currentPosition;
@@ -29,18 +142,96 @@ private:
     uint8_t targetPosition;
     bool isCalibrated;
     bool isMoving;
-    bool motorEnabled;
+    MotorPowerState motorPowerState;
     uint8_t errorCode;
     bool needsCalibration;          // True when encoder mismatch detected
     bool inCalibrationMode;         // True during guided calibration
 
     // Timing and management
     unsigned long lastUpdate;
-    unsigned long motorDisableTime;
-    bool motorDisablePending;
+    unsigned long powerStateSince;
+    bool motorDisablePending;       // Move finished: step down from ACTIVE after the delay
     unsigned long movementStartTime;
+    unsigned long lastIdleCheck;    // Last encoder position check while idle
+
+    // Motion state machine
+    MotionState motionState;
+    bool motionUsesEncoder;         // Current move is under encoder control
+    float motionTargetAngle;
+    float pidIntegralSum;
+    float pidPreviousError;
+    uint16_t pidIteration;
+    bool motionVerified;            // Target seen once, waiting for confirmation read
+    unsigned long settleStartTime;
+    uint16_t settleDuration;        // Upper bound; velocity detection usually ends it sooner
+    unsigned long lastSettleSample;
+    float lastSettleAngle;
+    unsigned long stillSince;       // Start of the run of samples below the velocity threshold
+    bool settleSampled;             // lastSettleAngle is valid
+    bool settledByVelocity;         // Last settle ended on detected stillness, not the timeout
+    float lastStepSpeed;
+    EncoderControlMode encoderControlMode;
+    unsigned long lastTrackingSample;
+    float trackingStartAngle;       // Encoder angle when the current segment started
+    long trackingStartSteps;        // Driver position when the current segment started
+    bool stepLossDetectionEnabled;
+    unsigned long lastSlipCheck;
+    float slipLastAngle;            // Encoder angle at the last step-loss check
+    float slipWheelTravel;          // Wheel travel since slipStartSteps (degrees, signed)
+    long slipStartSteps;            // Driver position the wheel travel is compared with
+
+    // Step-based fallback
+    bool shortestPathEnabled;
+    int backlashSteps;
+    int8_t lastMoveDirection;       // Direction of the last motor move (0 = unknown)
+    int8_t approachDirection;       // Final approach side (0 = either, +1 forward, -1 backward)
+    long pendingApproachSteps;      // Step move: return leg after overshooting the target
+    float segmentErrorOffset;       // Encoder move: aim offset past the target (degrees)
+
+    // Learned step table (see startRevolutionCalibration)
+    long stepsPerRevolution;        // Learned, or the driver's nominal value
+    uint16_t positionSteps[ConfigManager::MAX_FILTER_COUNT];  // Forward steps from position 1
+    uint8_t stepTableCount;         // Positions in positionSteps (0 = no table)
+    RevolutionCalibration revolutionCalibration;
+    CalibrationRoutine calibrationRoutine;
+    uint8_t calibrationReturnPosition;
+
+    // Backlash calibration in progress
+    int8_t backlashProbeDirection;  // Direction being probed (0 = preloading)
+    int backlashProbeSteps;         // Steps since the reversal
+    float backlashReferenceAngle;   // Encoder angle before the reversal
+    int backlashMeasured[2];        // Forward->backward and backward->forward results
+    uint8_t backlashMeasurements;
+
+    // Sensorless homing in progress (see startSensorlessHoming)
+    HomingPhase homingPhase;
+    long homingStartSteps;          // Driver position when the search started
+    unsigned long lastStallSample;
+    bool homedToStop;               // Step moves stay on their side of the stop
+
+    // Angle PID gains (see startPidAutotune)
+    float pidKp;                    // Steps per degree
+    float pidKi;
+    float pidKd;
+    bool pidGainsCustom;            // false = config.h defaults scaled to stepsPerRevolution
+    RelayAutotuner relayAutotuner;
+    float autotuneSetpoint;         // Encoder angle the relay oscillates around
+
+    // Move queue (see queueMoves)
+    QueuedMove moveQueue[MAX_QUEUED_MOVES];
+    uint8_t queueLength;
+    uint8_t queueIndex;             // Next entry to start
+    uint8_t queueCompleted;
+    QueueState queueState;
+    bool queueMoveRunning;          // The move in progress was started by the queue
+    bool queueNextPrepared;         // Next move planned while the current one settled
+    unsigned long dwellStartTime;
+
+    // Last move statistics
+    MoveStats lastMoveStats;
 
     // Configuration
+    uint8_t wheelIndex;             // EEPROM namespace (0 = first wheel)
     uint16_t displayUpdateInterval;
     uint16_t motorDisableDelay;
     bool debugMode;
@@ -48,8 +239,10 @@ private:
 public:
     /**
      * Constructor
+     * @param wheelIndex Wheel on this board (see MultiWheelController); only
+     *        the first wheel owns the display and the on-board AS5600
      */
-    FilterWheelController();
+    explicit FilterWheelController(uint8_t wheelIndex = 0);
 
     /**
      * Destructor
@@ -63,6 +256,16 @@ public:
      */
     bool init(MotorDriverType motorType = MotorDriverType::ULN2003_28BYJ48);
 
+    /**
+     * Initialize the controller with externally constructed components
+     * (e.g. simulated hardware). The driver must already be initialized.
+     * @param driver Motor driver to take ownership of
+     * @param encoderInstance Encoder to use instead of the AS5600 (may be null)
+     * @return true if initialization successful
+     */
+    bool init(std::unique_ptr<MotorDriver> driver,
+              std::unique_ptr<EncoderInterface> encoderInstance = nullptr);
+
     /**
      * Main update loop - call this from Arduino loop()
      */
@@ -79,16 +282,64 @@ public:
 
     /**
      * Move to specific filter position
+     * Starts the move and returns immediately; update() drives it to completion.
      * @param position Target position (1-based)
      * @return true if movement started successfully
      */
     bool moveToPosition(uint8_t position);
 
+    /**
+     * Get current motion state
+     */
+    MotionState getMotionState() const;
+
+    /**
+     * Get motion state name (for STATUS)
+     */
+    const char* getMotionStateName() const;
+
+    /**
+     * Select encoder control strategy (takes effect on the next move)
+     */
+    void setEncoderControlMode(EncoderControlMode mode);
+    EncoderControlMode getEncoderControlMode() const;
+
+    /**
+     * Encoder moves: watch for lost steps while stepping and re-plan
+     */
+    void setStepLossDetectionEnabled(bool enabled);
+    bool isStepLossDetectionEnabled() const;
+
+    /**
+     * Step-based fallback: allow backwards moves when shorter
+     */
+    void setShortestPathEnabled(bool enabled);
+    bool isShortestPathEnabled() const;
+
+    /**
+     * Gear play added when a move reverses direction (driver steps, saved)
+     */
+    void setBacklashSteps(int steps);
+    int getBacklashSteps() const;
+
+    /**
+     * Always finish moves travelling in one direction, so the wheel rests
+     * on the same side of the gear play (0 = off, +1 forward, -1 backward;
+     * saved). Moves from the other side overshoot and come back.
+     */
+    void setApproachDirection(int8_t direction);
+    int8_t getApproachDirection() const;
+
     /**
      * Get current filter position
      */
     uint8_t getCurrentPosition() const;
 
+    /**
+     * Get statistics of the last move (timing, iterations, steps, error)
+     */
+    const MoveStats& getLastMoveStats() const;
+
     /**
      * Get target position (if moving)
      */
@@ -99,6 +350,56 @@ public:
      */
     bool isMotorMoving() const;
 
+    /**
+     * Queue positions to visit back to back, each followed by its dwell time
+     * Replaces any previous queue; moves start from update(), the next one
+     * in the same pass the previous dwell ends.
+     * @param positions Positions (1-based)
+     * @param dwellMs Time to stay at each position (ms)
+     * @param count Entries (1 to MAX_QUEUED_MOVES)
+     * @return false if moving, or the count or a position is invalid
+     */
+    bool queueMoves(const uint8_t* positions, const uint32_t* dwellMs, uint8_t count);
+
+    /**
+     * Drop the queued entries (a move in progress still completes)
+     */
+    void clearMoveQueue();
+
+    /**
+     * Get move queue progress
+     */
+    QueueStatus getQueueStatus() const;
+    static const char* getQueueStateName(QueueState state);
+
+    /**
+     * Get coil power state
+     */
+    MotorPowerState getMotorPowerState() const;
+    static const char* getMotorPowerStateName(MotorPowerState state);
+
+    /**
+     * Full current for a manual move (SF/SB), waiting for the rotor to
+     * settle if the coils were off; call endManualMove() once it is done
+     */
+    void beginManualMove();
+
+    /**
+     * Power down in stages after a manual move, as after a filter move
+     */
+    void endManualMove();
+
+    /**
+     * Coils on at full current (ME) or off (MD), outside any move
+     */
+    void setMotorPower(bool enabled);
+
+    /**
+     * Full-current time after a move before holding or switching off (ms)
+     */
+    void setMotorDisableDelay(uint16_t delayMs);
+    uint16_t getMotorDisableDelay() const;
+
     /**
      * Emergency stop
      */
@@ -183,14 +484,88 @@ public:
 
     /**
      * Start revolution calibration
+     * Turns the wheel forward a little over one revolution while sampling
+     * the encoder, stores steps per revolution and the step offset of each
+     * position, then returns to the current filter. Runs from update().
+     * @return true if calibration started (requires the encoder)
      */
     bool startRevolutionCalibration();
 
+    /**
+     * Steps per wheel revolution in use (learned or driver nominal)
+     */
+    long getStepsPerRevolution() const;
+
+    /**
+     * Check if a learned step table is in use for the current filter count
+     */
+    bool hasStepTable() const;
+
+    /**
+     * Forward steps from position 1 to a position (learned or nominal)
+     */
+    long getPositionSteps(uint8_t position);
+
+    /**
+     * Forget the learned step table
+     */
+    void clearStepTable();
+
     /**
      * Start backlash calibration
+     * Takes up the play forward, then reverses one step at a time until the
+     * encoder sees the wheel move, and the same the other way. The average
+     * is stored as the backlash, then the wheel returns to the current
+     * filter. Runs from update().
+     * @return true if calibration started (requires the encoder)
      */
     bool startBacklashCalibration();
 
+    /**
+     * Start PID autotune
+     * Relay feedback around the current angle: moves a fixed amount towards
+     * the setpoint after each settled encoder read until the oscillation
+     * repeats, then derives and stores the angle PID gains and returns to
+     * the current filter. Runs from update().
+     * @return true if autotune started (requires the encoder)
+     */
+    bool startPidAutotune();
+
+    /**
+     * Start sensorless homing
+     * Moves towards the hard stop (HOMING_DIRECTION) until the driver
+     * reports a stall, backs off HOMING_ORIGIN_ANGLE to filter 1 and takes
+     * that as the step origin, then returns to the current filter with
+     * step-based moves. Runs from update().
+     * @return true if homing started (requires a driver with stall detection)
+     */
+    bool startSensorlessHoming();
+
+    /**
+     * Check if the step origin was set by sensorless homing
+     */
+    bool isHomedToStop() const;
+
+    /**
+     * Override the angle PID gains (persisted)
+     */
+    void setPidGains(float kp, float ki, float kd);
+
+    /**
+     * Angle PID gains in use (steps per degree, per iteration)
+     */
+    void getPidGains(float& kp, float& ki, float& kd) const;
+
+    /**
+     * Check if autotuned or manually set gains are in use
+     */
+    bool hasCustomPidGains() const;
+
+    /**
+     * Revert to the compile-time gains
+     */
+    void resetPidGains();
+
     // ========================================
     // STATUS AND DIAGNOSTICS
     // ========================================
@@ -201,7 +576,8 @@ public:
     String getSystemStatus() const;
 
     /**
-     * Get encoder angle (if available)
+     * Get encoder angle (if available), from the latest background sample
+     * when there is a recent one
      */
     float getEncoderAngle() const;
 
@@ -239,6 +615,13 @@ public:
      */
     bool isDebugMode() const;
 
+    uint8_t getWheelIndex() const { return wheelIndex; }
+
+    /**
+     * Command processor of this wheel (null before init)
+     */
+    CommandProcessor* getCommandProcessor() const { return commandProcessor.get(); }
+
     /**
      * Show splash screen
      */
@@ -270,6 +653,14 @@ public:
     DisplayManager* getDisplayManager() const;
     ConfigManager* getConfigManager() const;
     EncoderInterface* getEncoder() const;
+    StepGenerator* getStepGenerator() const;
+
+    /**
+     * Replace the step timer (e.g. a simulated timer on host builds)
+     * nullptr switches to polled stepping. Not allowed while moving.
+     * @return true if the timer was attached
+     */
+    bool setStepTimer(std::unique_ptr<StepTimer> timer);
 
     /**
      * Convert filter position to target angle (PUBLIC for diagnostics)
@@ -281,10 +672,19 @@ private:
      * Initialize components
      */
     bool initializeMotorDriver(MotorDriverType motorType);
+    bool initializeComponents();
     bool initializeDisplay();
     bool initializeEncoder();
     bool initializeCommandSystem();
 
+    /**
+     * Encoder angle from a sample at most ENCODER_SAMPLE_MAX_AGE old
+     * (ENCODER_IDLE_SAMPLE_MAX_AGE while idle), otherwise read directly
+     * (-1 if that fails). Either way the encoder's
+     * movement/direction tracking sees the reading.
+     */
+    float readEncoderAngle() const;
+
     /**
      * Convert angle to filter position
      */
@@ -296,9 +696,89 @@ private:
     float calculateAngularError(float currentAngle, float targetAngle);
 
     /**
-     * Move to target angle using encoder feedback (encoder-based control)
+     * Encoder-based control: read the angle and either finish, settle again
+     * or issue the next PID correction move
+     */
+    void evaluateEncoderPosition();
+
+    /**
+     * Tracking mode: start an approach segment of the given length
+     */
+    void startTrackingSegment(float error, float currentAngle);
+
+    /**
+     * Tracking mode: sample the encoder and move the step target if needed
+     */
+    void updateTrackingTarget();
+
+    /**
+     * Step-loss monitor: take the wheel and motor position as reference
+     */
+    void startStepLossMonitor(float currentAngle);
+
+    /**
+     * Step-loss monitor: compare the steps issued with the wheel travel,
+     * re-plan the rest of the move when the wheel fell behind
+     */
+    void updateStepLossMonitor();
+
+    /**
+     * Feedforward mode: convert the error to steps with the calibrated
+     * steps per revolution and move it in one trajectory
      */
-    bool moveToAngleWithFeedback(float targetAngle, float tolerance);
+    void startFeedforwardMove(float error, float currentAngle);
+
+    /**
+     * Revolution calibration: sample the encoder, finish after a full turn
+     */
+    void updateRevolutionCalibration();
+    void finishRevolutionCalibration();
+
+    /**
+     * Backlash calibration: issue probe steps and watch the encoder
+     */
+    void updateBacklashCalibration();
+    void finishBacklashCalibration(bool success);
+
+    /**
+     * PID autotune: feed each settled error to the relay, issue its move
+     */
+    void updatePidAutotune();
+    void finishPidAutotune(bool success);
+
+    /**
+     * Sensorless homing: poll for the stall, then back off to filter 1
+     */
+    void updateSensorlessHoming();
+    void finishSensorlessHoming(bool success);
+
+    /**
+     * Start a relative step move, adding the gear play on a reversal
+     * @return Steps actually issued
+     */
+    long startMotorMove(long steps);
+
+    /**
+     * Start a step-based move to targetPosition (no encoder / encoder failed)
+     */
+    void startStepMove();
+
+    /**
+     * Enter SETTLING for at most the given time
+     */
+    void startSettling(uint16_t durationMs);
+
+    /**
+     * Sample the encoder while settling
+     * @return true once the wheel has stayed below SETTLE_VELOCITY_THRESHOLD
+     *         for SETTLE_WINDOW, or the settle time ran out
+     */
+    bool updateSettleDetection();
+
+    /**
+     * Finish the current move: update position, stats, display and power
+     */
+    void completeMove(bool success);
 
     /**
      * Determine rotation direction for shortest path
@@ -311,7 +791,7 @@ private:
     void loadSystemConfiguration();
 
     /**
-     * Update motor state and handle movement
+     * Advance the motion state machine (steps the motor, no blocking)
      */
     void updateMotorMovement();
 
@@ -321,19 +801,53 @@ private:
     void updateDisplay();
 
     /**
-     * Handle motor power management
+     * Abort the move in progress (no event, error cleared)
+     */
+    void stopMotion();
+
+    /**
+     * Send a move event line if events are enabled
+     */
+    void emitMoveEvent(MoveEvent event);
+
+    /**
+     * Step the coil power down (ACTIVE -> HOLD -> OFF) once a move is over
      */
     void updateMotorPowerManagement();
 
     /**
-     * Calculate steps for movement
+     * Full current for a move
+     * @return true if the coils were off (the rotor needs to settle first)
+     */
+    bool powerUpMotor();
+
+    /**
+     * Switch the coils off
+     */
+    void powerDownMotor();
+
+    /**
+     * Start the first motion of a move (encoder or step control)
+     */
+    void beginMove();
+
+    /**
+     * Move queue: plan the next entry while the current move settles,
+     * start it once the move and its dwell are done
+     */
+    void updateMoveQueue();
+    void prepareQueuedMove();
+
+    /**
+     * Calculate steps for movement (shortest path when enabled, backlash
+     * taken into account when choosing the direction)
      */
-    int calculateStepsToPosition(uint8_t targetPos);
+    long calculateStepsToPosition(uint8_t targetPos);
 
     /**
-     * Apply backlash compensation
+     * Apply backlash compensation (extra steps when reversing direction)
      */
-    int applyBacklashCompensation(int steps);
+    long applyBacklashCompensation(long steps);
 
     /**
      * Validate position
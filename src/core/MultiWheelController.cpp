@@ -0,0 +1,147 @@
+#include "MultiWheelController.h"
+#include "../config.h"
+
+MultiWheelController::MultiWheelController()
+    : wheelCount(0)
+    , commandBuffer("")
+{
+}
+
+bool MultiWheelController::setStepTimer(std::unique_ptr<StepTimer> timer) {
+    if (wheelCount > 0) {
+        return false;
+    }
+    return stepScheduler.begin(std::move(timer));
+}
+
+void MultiWheelController::startStepScheduler() {
+    #if STEP_TIMER_ENABLED
+    if (!stepScheduler.isRunning()) {
+        stepScheduler.begin(StepTimer::createPlatformTimer(STEP_TIMER_NUMBER));
+    }
+    #endif
+}
+
+uint8_t MultiWheelController::addWheel(MotorDriverType motorType) {
+    if (wheelCount >= MAX_WHEELS) {
+        return 0;
+    }
+    startStepScheduler();
+
+    std::unique_ptr<FilterWheelController> wheel(new FilterWheelController(wheelCount));
+    if (!wheel->init(motorType)) {
+        return 0;
+    }
+    return attachWheel(std::move(wheel));
+}
+
+uint8_t MultiWheelController::addWheel(std::unique_ptr<MotorDriver> driver,
+                                       std::unique_ptr<EncoderInterface> encoder) {
+    if (wheelCount >= MAX_WHEELS) {
+        return 0;
+    }
+    startStepScheduler();
+
+    std::unique_ptr<FilterWheelController> wheel(new FilterWheelController(wheelCount));
+    if (!wheel->init(std::move(driver), std::move(encoder))) {
+        return 0;
+    }
+    return attachWheel(std::move(wheel));
+}
+
+uint8_t MultiWheelController::attachWheel(std::unique_ptr<FilterWheelController> wheel) {
+    // The scheduler holds the hardware timer, so the wheel found none of
+    // its own and polls; a channel moves its steps back into the interrupt
+    std::unique_ptr<StepTimer> channel = stepScheduler.createChannel();
+    if (channel) {
+        wheel->setStepTimer(std::move(channel));
+    }
+
+    wheels[wheelCount] = std::move(wheel);
+    wheelCount++;
+
+    // A single wheel keeps the unaddressed event lines
+    if (wheelCount > 1) {
+        for (uint8_t i = 0; i < wheelCount; i++) {
+            wheels[i]->getCommandProcessor()->setEventPrefix(String(i + 1) + ":");
+        }
+    }
+    return wheelCount;
+}
+
+FilterWheelController* MultiWheelController::getWheel(uint8_t number) const {
+    if (number < 1 || number > wheelCount) {
+        return nullptr;
+    }
+    return wheels[number - 1].get();
+}
+
+void MultiWheelController::update() {
+    for (uint8_t i = 0; i < wheelCount; i++) {
+        wheels[i]->update();
+    }
+}
+
+void MultiWheelController::handleSerial() {
+    while (Serial.available()) {
+        char c = Serial.read();
+
+        if (c == '\n' || c == '\r') {
+            if (commandBuffer.length() > 0) {
+                String response;
+                executeCommand(commandBuffer, response);
+                Serial.println(response);
+                commandBuffer = "";
+            }
+        } else if (c >= 32 && c <= 126) {  // Printable characters only
+            commandBuffer += c;
+        }
+    }
+}
+
+CommandResult MultiWheelController::executeCommand(const String& command, String& response) {
+    String line = command;
+    line.trim();
+    if (line.startsWith("#")) {
+        line = line.substring(1);
+    }
+
+    // Optional "N:" address; digits never start a command name
+    String address = "";
+    uint8_t number = 1;
+    int colon = line.indexOf(':');
+    if (colon > 0 && isDigit(line.charAt(0))) {
+        address = line.substring(0, colon);
+        line = line.substring(colon + 1);
+
+        // Digits only and in range, so "1x:" or "257:" never reach a wheel
+        number = 0;
+        bool digitsOnly = address.length() <= 3;
+        for (unsigned int i = 0; i < address.length() && digitsOnly; i++) {
+            digitsOnly = isDigit(address.charAt(i));
+        }
+        long value = digitsOnly ? address.toInt() : 0;
+        if (value >= 1 && value <= wheelCount) {
+            number = (uint8_t)value;
+        }
+    }
+
+    String upper = line;
+    upper.toUpperCase();
+    CommandResult result;
+    FilterWheelController* wheel = getWheel(number);
+    if (address.isEmpty() && upper == "WHEELS") {
+        response = "WHEELS:" + String(wheelCount);
+        result = CommandResult::SUCCESS;
+    } else if (!wheel || !wheel->getCommandProcessor()) {
+        response = "ERROR:Unknown wheel";
+        result = CommandResult::ERROR_INVALID_PARAMETER;
+    } else {
+        result = wheel->getCommandProcessor()->executeCommand(line, response);
+    }
+
+    if (!address.isEmpty()) {
+        response = address + ":" + response;
+    }
+    return result;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "FilterWheelController.h"
+#include "../config/ConfigManager.h"
+#include "../motion/StepScheduler.h"
+#include <memory>
+
+/**
+ * Several wheels driven from one board (e.g. a filter wheel plus an ND or
+ * occulter wheel)
+ *
+ * Each wheel is a complete FilterWheelController with its own EEPROM block
+ * (ConfigManager namespace). update() advances every wheel in turn; moves
+ * are non-blocking state machines, and the steps of all wheels are issued
+ * from one hardware timer through a StepScheduler, so the wheels step
+ * concurrently rather than one after another.
+ *
+ * Serial commands are read here and routed by an optional address:
+ * "#2:MP3" goes to wheel 2, "#MP3" to wheel 1. The reply to an addressed
+ * command carries the same prefix ("2:M3"). With more than one wheel,
+ * event lines are prefixed too ("!EVT:2:MOVE_DONE,...").
+ */
+class MultiWheelController {
+public:
+    static constexpr uint8_t MAX_WHEELS = ConfigManager::MAX_WHEELS;
+
+    MultiWheelController();
+
+    /**
+     * Hardware timer shared by the steps of every wheel (e.g. a simulated
+     * timer on host builds). Call before adding wheels; otherwise the
+     * platform timer STEP_TIMER_NUMBER is taken with the first wheel.
+     * @return true if the timer was taken
+     */
+    bool setStepTimer(std::unique_ptr<StepTimer> timer);
+
+    StepScheduler& getStepScheduler() { return stepScheduler; }
+
+    /**
+     * Add a wheel with the configured driver and the on-board AS5600
+     * (first wheel only, see FilterWheelController::init)
+     * @return Wheel number (1-based), 0 if it failed or all slots are taken
+     */
+    uint8_t addWheel(MotorDriverType motorType);
+
+    /**
+     * Add a wheel with externally constructed components
+     * @param driver Initialized motor driver
+     * @param encoder Encoder of this wheel (may be null)
+     * @return Wheel number (1-based), 0 if it failed or all slots are taken
+     */
+    uint8_t addWheel(std::unique_ptr<MotorDriver> driver, std::unique_ptr<EncoderInterface> encoder);
+
+    uint8_t getWheelCount() const { return wheelCount; }
+
+    /**
+     * Wheel by number (1-based), nullptr if there is none
+     */
+    FilterWheelController* getWheel(uint8_t number) const;
+
+    /**
+     * Advance every wheel (motion, display, power management)
+     */
+    void update();
+
+    /**
+     * Read serial input and dispatch complete command lines
+     */
+    void handleSerial();
+
+    /**
+     * Route one command line to its wheel
+     * @param command Command with optional '#' and "N:" address
+     * @param response Reply, prefixed with the address if one was given
+     */
+    CommandResult executeCommand(const String& command, String& response);
+
+private:
+    StepScheduler stepScheduler;    // Must outlive the wheels (they hold its channels)
+    std::unique_ptr<FilterWheelController> wheels[MAX_WHEELS];
+    uint8_t wheelCount;
+    String commandBuffer;
+
+    /**
+     * Take the platform step timer if none was set
+     */
+    void startStepScheduler();
+
+    /**
+     * Take ownership of an initialized wheel, give it a scheduler channel
+     * and set up its event prefix
+     */
+    uint8_t attachWheel(std::unique_ptr<FilterWheelController> wheel);
+};
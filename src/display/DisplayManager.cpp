@@ -1,6 +1,7 @@
 #include "DisplayManager.h"
 #include "../config.h"
 #include <Arduino.h>
+#include "../core/Clock.h"
 #include <Wire.h>
 #include <EEPROM.h>
 
@@ -51,7 +52,7 @@ void DisplayManager::update() {
         return;
     }
 
-    unsigned long currentTime = millis();
+    unsigned long currentTime = Clock::system().millis();
     if (currentTime - lastUpdate >= updateInterval) {
         performUpdate();
         lastUpdate = currentTime;
@@ -65,7 +66,7 @@ void DisplayManager::forceUpdate() {
     }
 
     performUpdate();
-    lastUpdate = millis();
+    lastUpdate = Clock::system().millis();
     needsUpdate = false;
 }
 
@@ -265,7 +266,7 @@ void DisplayManager::runDisplayTest() {
         }
     }
     forceUpdate();
-    delay(1000);
+    Clock::system().delay(1000);
 
     // Test pattern 2: Text at different positions
     for (uint8_t i = 0; i < 3; i++) {
@@ -274,7 +275,7 @@ void DisplayManager::runDisplayTest() {
         snprintf(testText, sizeof(testText), "Test %d", i + 1);
         drawCenteredText(testText, getStatusLineY() + (i * 12), 1);
         forceUpdate();
-        delay(500);
+        Clock::system().delay(500);
     }
 
     clear();
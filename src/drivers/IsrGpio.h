@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Arduino.h>
+
+#if defined(ESP32) && !defined(ARDUINO_HOST)
+#include <hal/gpio_ll.h>
+#include <esp_rom_sys.h>
+#endif
+
+/**
+ * Pin writes and pulse delays for the step timer interrupt
+ * On the ESP32 they stay out of flash (an inlined register write and a ROM
+ * delay), so steps keep going while a flash write has the cache disabled.
+ */
+inline __attribute__((always_inline)) void isrDigitalWrite(uint8_t pin, uint8_t level) {
+#if defined(ESP32) && !defined(ARDUINO_HOST)
+    gpio_ll_set_level(&GPIO, (gpio_num_t)pin, level);
+#else
+    digitalWrite(pin, level);
+#endif
+}
+
+inline __attribute__((always_inline)) void isrDelayMicroseconds(uint32_t us) {
+#if defined(ESP32) && !defined(ARDUINO_HOST)
+    esp_rom_delay_us(us);
+#else
+    delayMicroseconds(us);
+#endif
+}
@@ -6,9 +6,19 @@
 /**
  * Abstract base class for motor drivers
  * Provides common interface for different stepper motor drivers
+ *
+ * Units: positions, moves and stepOnce() count driver steps (microsteps on
+ * drivers that microstep). Speed, acceleration and getStepsPerRevolution()
+ * are in full steps of the motor, so they do not change with microstepping.
  */
 class MotorDriver {
 public:
+    /**
+     * Step function for timerStep(), see there
+     */
+    typedef void (*TimerStepFunction)(MotorDriver* driver, int8_t direction, bool coarse);
+
+    MotorDriver() : timerStepFunction(&MotorDriver::stepThroughDriver) {}
     virtual ~MotorDriver() = default;
 
     // Basic motor control
@@ -26,6 +36,32 @@ public:
     virtual void stop() = 0;
     virtual void emergencyStop() = 0;
 
+    /**
+     * Emit one driver step (microstep) immediately, bypassing the driver's own speed ramp
+     * (step timing comes from the caller, see StepGenerator)
+     * @param direction +1 or -1, before direction reversal is applied
+     */
+    virtual void stepOnce(int8_t direction) = 0;
+
+    /**
+     * stepOnce() for the step timer interrupt, with coarse stepping chosen
+     * per step. Not virtual: on the ESP32 the vtable and library code are in
+     * flash, which cannot be read while a flash write (EEPROM commit) runs,
+     * so drivers pass an IRAM_ATTR function that writes the pins itself.
+     * Drivers that do not are only safe from the main loop.
+     * @param coarse Move the coils only on coarse step boundaries (ULN2003
+     *        full steps in half-step mode); positions still count driver steps
+     */
+    inline __attribute__((always_inline)) void timerStep(int8_t direction, bool coarse) {
+        timerStepFunction(this, direction, coarse);
+    }
+
+    /**
+     * Leave coarse stepping between steps: energize the driver step the
+     * coils were held back from, if any. Call with the step timer idle.
+     */
+    virtual void setCoarseStepping(bool coarse) { /* Default: no-op */ }
+
     // Motor configuration
     virtual void setSpeed(float speed) = 0;
     virtual void setMaxSpeed(float maxSpeed) = 0;
@@ -56,10 +92,26 @@ public:
     virtual void setMicrosteps(uint16_t microsteps) { /* Default: no-op */ }
     virtual uint16_t getMicrosteps() const { return 1; }
     virtual void setCurrent(uint16_t currentMA) { /* Default: no-op */ }
+
+    /**
+     * Drive the coils at currentMA (at most the setCurrent() value) without
+     * changing or saving the configured current: hold/run switching
+     */
+    virtual void applyCurrent(uint16_t currentMA) { /* Default: no-op */ }
     virtual uint16_t getCurrent() const { return 0; }
     virtual void setStealthChopEnabled(bool enabled) { /* Default: no-op */ }
     virtual bool isStealthChopEnabled() const { return false; }
 
+    /**
+     * StallGuard for sensorless homing: switch to a chopper mode and
+     * threshold where it reports stalls, then poll isStallDetected() while
+     * moving (readings at low speed are not meaningful)
+     * @return false if the driver cannot detect stalls
+     */
+    virtual bool beginStallDetection() { return false; }
+    virtual void endStallDetection() { /* Default: no-op */ }
+    virtual bool isStallDetected() const { return false; }
+
     // Additional methods needed by command handlers
     virtual float getCurrentSpeed() const { return getSpeed(); }
     virtual void setDisableDelay(uint32_t delayMs) { /* Default: no-op */ }
@@ -97,4 +149,21 @@ public:
     // Steps per revolution configuration
     virtual void setStepsPerRevolution(int steps) { /* Default: no-op */ }
     virtual int getStepsPerRevolution() const { return 2048; /* Default value */ }
+
+    /**
+     * Driver steps per revolution: the unit of positions and moves
+     */
+    long getMicrostepsPerRevolution() const {
+        return (long)getStepsPerRevolution() * getMicrosteps();
+    }
+
+protected:
+    explicit MotorDriver(TimerStepFunction stepFunction) : timerStepFunction(stepFunction) {}
+
+private:
+    TimerStepFunction timerStepFunction;
+
+    static void stepThroughDriver(MotorDriver* driver, int8_t direction, bool coarse) {
+        driver->stepOnce(direction);
+    }
 };
\ No newline at end of file
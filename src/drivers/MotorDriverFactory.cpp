@@ -23,7 +23,7 @@ std::unique_ptr<MotorDriver> MotorDriverFactory::createULN2003Driver(const ULN20
 std::unique_ptr<MotorDriver> MotorDriverFactory::createTMC2209Driver(const TMC2209Config& config) {
     auto driver = make_unique_compat<TMC2209Driver>(
         config.stepPin, config.dirPin, config.enablePin,
-        config.rxPin, config.txPin, config.slaveAddress
+        config.rxPin, config.txPin, config.slaveAddress, config.eepromBase
     );
 
     // TMC2209 driver is now fully implemented
@@ -34,7 +34,7 @@ std::unique_ptr<MotorDriver> MotorDriverFactory::createTMC2209Driver(const TMC22
 
 std::unique_ptr<MotorDriver> MotorDriverFactory::createTMC2130Driver(const TMC2130Config& config) {
     auto driver = make_unique_compat<TMC2130Driver>(
-        config.stepPin, config.dirPin, config.enablePin, config.csPin
+        config.stepPin, config.dirPin, config.enablePin, config.csPin, config.eepromBase
     );
 
     // TMC2130 driver configuration will be applied in init()
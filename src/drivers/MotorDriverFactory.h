@@ -36,6 +36,7 @@ struct TMC2209Config {
     uint8_t stepPin, dirPin, enablePin;
     uint8_t rxPin, txPin;
     uint8_t slaveAddress = 0;
+    uint16_t eepromBase = 0;    // EEPROM block of the wheel (ConfigManager::getWheelBaseAddress)
     uint16_t microsteps = 16;
     uint16_t currentMA = 800;
     float speed = 1000.0;
@@ -52,6 +53,7 @@ struct TMC2209Config {
 struct TMC2130Config {
     uint8_t stepPin, dirPin, enablePin;
     uint8_t csPin;  // SPI chip select
+    uint16_t eepromBase = 0;    // EEPROM block of the wheel (ConfigManager::getWheelBaseAddress)
     uint16_t microsteps = 16;
     uint16_t currentMA = 800;
     float speed = 1000.0;
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Arduino.h>
+#include <AccelStepper.h>
+
+/**
+ * AccelStepper with a single-step entry point for externally timed motion
+ * (StepGenerator). The library's own speed ramp is bypassed: each call emits
+ * one step immediately and leaves the stepper idle at the new position, so
+ * run()/moveTo() keep working afterwards.
+ *
+ * The position is kept here as well as in the library, so the step timer
+ * interrupt can count steps with countStep() without calling library code
+ * (in flash on the ESP32). The library catches up on its next use.
+ */
+class ProfileAccelStepper : public AccelStepper {
+public:
+    using AccelStepper::AccelStepper;
+
+    /**
+     * Emit one step now
+     * @param direction +1 or -1
+     */
+    void singleStep(int8_t direction) {
+        long next = stepPosition + direction;
+        _direction = (direction > 0) ? DIRECTION_CW : DIRECTION_CCW;
+        setCurrentPosition(next);
+        step(next);
+    }
+
+    /**
+     * Count one step whose pins the caller wrote itself (step interrupt)
+     * @param direction +1 or -1
+     * @return New position
+     */
+    inline __attribute__((always_inline)) long countStep(int8_t direction) {
+        long next = stepPosition + direction;
+        stepPosition = next;
+        return next;
+    }
+
+    // Library calls that see steps counted by countStep()
+    long currentPosition() { return stepPosition; }
+    long targetPosition() { syncPosition(); return AccelStepper::targetPosition(); }
+    long distanceToGo() { syncPosition(); return AccelStepper::distanceToGo(); }
+    void move(long relative) { syncPosition(); AccelStepper::move(relative); }
+    void moveTo(long absolute) { syncPosition(); AccelStepper::moveTo(absolute); }
+    bool run() {
+        syncPosition();
+        bool running = AccelStepper::run();
+        stepPosition = AccelStepper::currentPosition();
+        return running;
+    }
+    void runToPosition() {
+        syncPosition();
+        AccelStepper::runToPosition();
+        stepPosition = AccelStepper::currentPosition();
+    }
+    bool isRunning() { syncPosition(); return AccelStepper::isRunning(); }
+    void stop() { syncPosition(); AccelStepper::stop(); }
+
+    void setCurrentPosition(long position) {
+        AccelStepper::setCurrentPosition(position);
+        stepPosition = position;
+    }
+
+private:
+    volatile long stepPosition = 0;
+
+    void syncPosition() {
+        long position = stepPosition;
+        if (AccelStepper::currentPosition() != position) {
+            AccelStepper::setCurrentPosition(position);
+        }
+    }
+};
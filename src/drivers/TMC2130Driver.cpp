@@ -1,13 +1,17 @@
 #include "TMC2130Driver.h"
 #include "../config.h"
 #include <Arduino.h>
+#include "../core/Clock.h"
 #include <EEPROM.h>
+#include "IsrGpio.h"
 
 #ifdef MOTOR_DRIVER_TMC2130
 
 // Constructor
-TMC2130Driver::TMC2130Driver(uint8_t stepPin, uint8_t dirPin, uint8_t enablePin, uint8_t csPin)
-    : stepPin(stepPin), dirPin(dirPin), enablePin(enablePin), csPin(csPin)
+TMC2130Driver::TMC2130Driver(uint8_t stepPin, uint8_t dirPin, uint8_t enablePin, uint8_t csPin,
+                             uint16_t eepromBase)
+    : MotorDriver(&TMC2130Driver::timerStep)
+    , stepPin(stepPin), dirPin(dirPin), enablePin(enablePin), csPin(csPin), eepromBase(eepromBase)
     , tmcDriver(nullptr), stepper(nullptr)
     , motorEnabled(false), directionReversed(false)
     , currentPosition(0), targetPosition(0), isMoving(false)
@@ -80,7 +84,7 @@ void TMC2130Driver::init() {
     tmcDriver->sedn(0b01);   // Current down step
 
     // Initialize AccelStepper for movement control
-    stepper = new AccelStepper(AccelStepper::DRIVER, stepPin, dirPin);
+    stepper = new ProfileAccelStepper(AccelStepper::DRIVER, stepPin, dirPin);
     stepper->setMaxSpeed(maxSpeed * microsteps);
     stepper->setAcceleration(acceleration * microsteps);
     stepper->setSpeed(speed * microsteps);
@@ -96,9 +100,9 @@ void TMC2130Driver::init() {
 void TMC2130Driver::move(long steps) {
     if (!tmcDriver || !stepper) return;
 
-    long actualSteps = steps * microsteps;
-    stepper->move(actualSteps);
-    targetPosition = currentPosition + steps;
+    // Positions are in microsteps, the unit the controller plans in
+    stepper->move(steps);
+    targetPosition = stepper->targetPosition();
     isMoving = true;
     enableMotor();
 }
@@ -106,8 +110,7 @@ void TMC2130Driver::move(long steps) {
 void TMC2130Driver::moveTo(long position) {
     if (!tmcDriver || !stepper) return;
 
-    long actualPosition = position * microsteps;
-    stepper->moveTo(actualPosition);
+    stepper->moveTo(position);
     targetPosition = position;
     isMoving = true;
     enableMotor();
@@ -118,13 +121,13 @@ void TMC2130Driver::setCurrentPosition(long position) {
 
     currentPosition = position;
     targetPosition = position;
-    stepper->setCurrentPosition(position * microsteps);
+    stepper->setCurrentPosition(position);
     isMoving = false;
 }
 
 long TMC2130Driver::getCurrentPosition() const {
     if (!stepper) return 0;
-    return stepper->currentPosition() / microsteps;
+    return stepper->currentPosition();
 }
 
 long TMC2130Driver::getTargetPosition() const {
@@ -138,7 +141,7 @@ bool TMC2130Driver::run() {
 
     if (stillRunning) {
         // Update current position
-        currentPosition = stepper->currentPosition() / microsteps;
+        currentPosition = stepper->currentPosition();
 
         // Check for stall detection
         if (stallGuardEnabled && tmcDriver) {
@@ -206,6 +209,26 @@ void TMC2130Driver::emergencyStop() {
 }
 
 // Speed and acceleration methods
+void TMC2130Driver::stepOnce(int8_t direction) {
+    if (!stepper || !motorEnabled) return;
+
+    stepper->singleStep(direction);
+    currentPosition = stepper->currentPosition();
+}
+
+void IRAM_ATTR TMC2130Driver::timerStep(MotorDriver* driver, int8_t direction, bool coarse) {
+    TMC2130Driver* self = static_cast<TMC2130Driver*>(driver);
+    if (!self->stepper || !self->motorEnabled) return;
+
+    // The pulse AccelStepper's DRIVER mode sends (direction pin inverted
+    // when reversed, 1 us step pulse), written directly
+    isrDigitalWrite(self->dirPin, ((direction > 0) != self->directionReversed) ? HIGH : LOW);
+    isrDigitalWrite(self->stepPin, HIGH);
+    isrDelayMicroseconds(1);
+    isrDigitalWrite(self->stepPin, LOW);
+    self->currentPosition = self->stepper->countStep(direction);
+}
+
 void TMC2130Driver::setSpeed(float speed) {
     this->speed = speed;
     if (stepper) {
@@ -276,6 +299,14 @@ void TMC2130Driver::setMicrosteps(uint16_t microsteps) {
         return;
     }
 
+    // Keep the physical position: positions are counted in microsteps
+    if (stepper) {
+        long position = stepper->currentPosition() * microsteps / this->microsteps;
+        stepper->setCurrentPosition(position);
+        currentPosition = position;
+        targetPosition = position;
+    }
+
     this->microsteps = microsteps;
     if (tmcDriver) {
         tmcDriver->microsteps(microsteps);
@@ -315,6 +346,15 @@ void TMC2130Driver::setCurrent(uint16_t currentMA) {
     Serial.print("Motor current set to: "); Serial.print(currentMA); Serial.println(" mA");
 }
 
+void TMC2130Driver::applyCurrent(uint16_t currentMA) {
+    if (currentMA < MIN_MOTOR_CURRENT) currentMA = MIN_MOTOR_CURRENT;
+    if (currentMA > this->currentMA) currentMA = this->currentMA;
+
+    if (tmcDriver) {
+        tmcDriver->rms_current(currentMA);
+    }
+}
+
 uint16_t TMC2130Driver::getCurrent() const {
     return currentMA;
 }
@@ -373,8 +413,26 @@ int8_t TMC2130Driver::getStallGuardThreshold() const {
     return stallGuardThreshold;
 }
 
+bool TMC2130Driver::beginStallDetection() {
+    if (!tmcDriver) return false;
+
+    // StallGuard2 only measures the load in SpreadCycle
+    tmcDriver->en_pwm_mode(false);
+    tmcDriver->sgt(HOMING_STALL_THRESHOLD);
+    tmcDriver->sfilt(1);
+    return true;
+}
+
+void TMC2130Driver::endStallDetection() {
+    if (!tmcDriver) return;
+
+    tmcDriver->en_pwm_mode(stealthChopEnabled);
+    tmcDriver->sgt(stallGuardThreshold);
+}
+
 bool TMC2130Driver::isStallDetected() const {
-    if (tmcDriver && stallGuardEnabled) {
+    // Stall when sg_result reaches 0 (also while homing with StallGuard off)
+    if (tmcDriver) {
         return (tmcDriver->sg_result() == 0);
     }
     return false;
@@ -452,80 +510,28 @@ bool TMC2130Driver::checkTMCCommunication() const {
     return (tmcDriver->toff() == 5);
 }
 
-// Sensorless homing using StallGuard
-bool TMC2130Driver::performSensorlessHoming(bool direction, uint32_t timeoutMs) {
-    if (!tmcDriver || !stepper) return false;
-
-    Serial.println("Starting sensorless homing...");
-
-    // Save current settings
-    bool savedStallGuard = stallGuardEnabled;
-    int8_t savedThreshold = stallGuardThreshold;
-
-    // Enable StallGuard for homing
-    setStallGuardEnabled(true);
-    setStallGuardThreshold(8);  // Sensitive threshold for homing
-
-    // Set direction and enable motor
-    stepper->setSpeed(direction ? 200 : -200);  // Slow speed for homing
-    enableMotor();
-
-    unsigned long startTime = millis();
-    bool stalled = false;
-
-    // Move until stall or timeout
-    while ((millis() - startTime) < timeoutMs) {
-        stepper->runSpeed();
-
-        if (tmcDriver->sg_result() == 0) {
-            stalled = true;
-            Serial.println("Stall detected - home position found!");
-            break;
-        }
-
-        delay(1);
-    }
-
-    // Stop motor
-    stop();
-
-    if (stalled) {
-        // Set this as home position
-        setCurrentPosition(0);
-        Serial.println("Homing successful!");
-    } else {
-        Serial.println("Homing timeout!");
-    }
-
-    // Restore settings
-    setStallGuardEnabled(savedStallGuard);
-    setStallGuardThreshold(savedThreshold);
-
-    return stalled;
-}
-
 // Helper methods for EEPROM
 void TMC2130Driver::saveConfigToEEPROM() {
-    EEPROM.write(EEPROM_TMC_CONFIG_FLAG, 0xFF);
-    EEPROM.put(EEPROM_TMC_MICROSTEPS, microsteps);
-    EEPROM.put(EEPROM_TMC_CURRENT, currentMA);
-    EEPROM.write(EEPROM_TMC_STEALTHCHOP, stealthChopEnabled ? 1 : 0);
+    EEPROM.write(eepromBase + EEPROM_TMC_CONFIG_FLAG, 0xFF);
+    EEPROM.put(eepromBase + EEPROM_TMC_MICROSTEPS, microsteps);
+    EEPROM.put(eepromBase + EEPROM_TMC_CURRENT, currentMA);
+    EEPROM.write(eepromBase + EEPROM_TMC_STEALTHCHOP, stealthChopEnabled ? 1 : 0);
     // Save TMC2130-specific settings at different addresses
-    EEPROM.write(EEPROM_TMC_CONFIG_FLAG + 1, stallGuardEnabled ? 1 : 0);
-    EEPROM.write(EEPROM_TMC_CONFIG_FLAG + 2, stallGuardThreshold);
+    EEPROM.write(eepromBase + EEPROM_TMC_CONFIG_FLAG + 1, stallGuardEnabled ? 1 : 0);
+    EEPROM.write(eepromBase + EEPROM_TMC_CONFIG_FLAG + 2, stallGuardThreshold);
     EEPROM.commit();
 }
 
 void TMC2130Driver::loadConfigFromEEPROM() {
-    if (EEPROM.read(EEPROM_TMC_CONFIG_FLAG) == 0xFF) {
+    if (EEPROM.read(eepromBase + EEPROM_TMC_CONFIG_FLAG) == 0xFF) {
         uint16_t savedMicrosteps, savedCurrent;
-        EEPROM.get(EEPROM_TMC_MICROSTEPS, savedMicrosteps);
-        EEPROM.get(EEPROM_TMC_CURRENT, savedCurrent);
-        stealthChopEnabled = (EEPROM.read(EEPROM_TMC_STEALTHCHOP) == 1);
+        EEPROM.get(eepromBase + EEPROM_TMC_MICROSTEPS, savedMicrosteps);
+        EEPROM.get(eepromBase + EEPROM_TMC_CURRENT, savedCurrent);
+        stealthChopEnabled = (EEPROM.read(eepromBase + EEPROM_TMC_STEALTHCHOP) == 1);
 
         // Load TMC2130-specific settings
-        stallGuardEnabled = (EEPROM.read(EEPROM_TMC_CONFIG_FLAG + 1) == 1);
-        stallGuardThreshold = EEPROM.read(EEPROM_TMC_CONFIG_FLAG + 2);
+        stallGuardEnabled = (EEPROM.read(eepromBase + EEPROM_TMC_CONFIG_FLAG + 1) == 1);
+        stallGuardThreshold = EEPROM.read(eepromBase + EEPROM_TMC_CONFIG_FLAG + 2);
 
         // Validate loaded values
         if (savedMicrosteps == 1 || savedMicrosteps == 2 || savedMicrosteps == 4 ||
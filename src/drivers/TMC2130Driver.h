@@ -6,7 +6,7 @@
 #ifdef MOTOR_DRIVER_TMC2130
 #include "../config.h"
 #include <TMCStepper.h>
-#include <AccelStepper.h>
+#include "ProfileAccelStepper.h"
 #include <SPI.h>
 
 /**
@@ -17,11 +17,12 @@ class TMC2130Driver : public MotorDriver {
 private:
     // TMC2130 driver instance
     TMC2130Stepper* tmcDriver;
-    AccelStepper* stepper;
+    ProfileAccelStepper* stepper;
 
     // Pin assignments
     uint8_t stepPin, dirPin, enablePin;
     uint8_t csPin;  // SPI chip select pin
+    uint16_t eepromBase;   // Start of this wheel's EEPROM block
 
     // Motor state
     bool motorEnabled;
@@ -46,6 +47,8 @@ private:
     void saveConfigToEEPROM();
     void loadConfigFromEEPROM();
 
+    static void timerStep(MotorDriver* driver, int8_t direction, bool coarse);
+
 public:
     /**
      * Constructor for TMC2130 driver
@@ -54,7 +57,8 @@ public:
      * @param enablePin Enable/disable pin
      * @param csPin SPI chip select pin
      */
-    TMC2130Driver(uint8_t stepPin, uint8_t dirPin, uint8_t enablePin, uint8_t csPin);
+    TMC2130Driver(uint8_t stepPin, uint8_t dirPin, uint8_t enablePin, uint8_t csPin,
+                  uint16_t eepromBase = 0);
 
     // MotorDriver interface implementation
     void init() override;
@@ -69,6 +73,7 @@ public:
     bool isRunning() const override;
     void stop() override;
     void emergencyStop() override;
+    void stepOnce(int8_t direction) override;
 
     void setSpeed(float speed) override;
     void setMaxSpeed(float maxSpeed) override;
@@ -95,7 +100,9 @@ public:
     // TMC2130-specific advanced features
     void setMicrosteps(uint16_t microsteps) override;
     uint16_t getMicrosteps() const override;
+    int getStepsPerRevolution() const override { return MOTOR_STEPS_PER_REV; }
     void setCurrent(uint16_t currentMA) override;
+    void applyCurrent(uint16_t currentMA) override;
     uint16_t getCurrent() const override;
     void setStealthChopEnabled(bool enabled) override;
     bool isStealthChopEnabled() const override;
@@ -105,7 +112,9 @@ public:
     bool isStallGuardEnabled() const;
     void setStallGuardThreshold(int8_t threshold);
     int8_t getStallGuardThreshold() const;
-    bool isStallDetected() const;
+    bool beginStallDetection() override;
+    void endStallDetection() override;
+    bool isStallDetected() const override;
 
     // Diagnostics
     uint32_t getDriverStatus() const;
@@ -116,9 +125,6 @@ public:
     // TMC Status and Error Reporting
     String getTMCStatusString() const;
     bool checkTMCCommunication() const;
-
-    // Sensorless homing capability
-    bool performSensorlessHoming(bool direction, uint32_t timeoutMs = 10000);
 };
 
 #else // Not using TMC2130
@@ -126,7 +132,8 @@ public:
 // Placeholder class when TMC2130 is not selected
 class TMC2130Driver : public MotorDriver {
 public:
-    TMC2130Driver(uint8_t stepPin, uint8_t dirPin, uint8_t enablePin, uint8_t csPin) {}
+    TMC2130Driver(uint8_t stepPin, uint8_t dirPin, uint8_t enablePin, uint8_t csPin,
+                  uint16_t eepromBase = 0) {}
 
     void init() override {}
     void move(long steps) override {}
@@ -139,6 +146,7 @@ public:
     bool isRunning() const override { return false; }
     void stop() override {}
     void emergencyStop() override {}
+    void stepOnce(int8_t direction) override {}
     void setSpeed(float speed) override {}
     void setMaxSpeed(float maxSpeed) override {}
     void setAcceleration(float acceleration) override {}
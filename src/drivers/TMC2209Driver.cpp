@@ -2,14 +2,17 @@
 #include "../config.h"
 #include <Arduino.h>
 #include <EEPROM.h>
+#include "IsrGpio.h"
 
 #ifdef MOTOR_DRIVER_TMC2209
 
 // Constructor
 TMC2209Driver::TMC2209Driver(uint8_t stepPin, uint8_t dirPin, uint8_t enablePin,
-                             uint8_t rxPin, uint8_t txPin, uint8_t slaveAddr)
-    : stepPin(stepPin), dirPin(dirPin), enablePin(enablePin)
-    , rxPin(rxPin), txPin(txPin), slaveAddress(slaveAddr)
+                             uint8_t rxPin, uint8_t txPin, uint8_t slaveAddr,
+                             uint16_t eepromBase)
+    : MotorDriver(&TMC2209Driver::timerStep)
+    , stepPin(stepPin), dirPin(dirPin), enablePin(enablePin)
+    , rxPin(rxPin), txPin(txPin), slaveAddress(slaveAddr), eepromBase(eepromBase)
     , tmcDriver(nullptr), stepper(nullptr), tmcSerial(nullptr)
     , motorEnabled(false), directionReversed(false)
     , currentPosition(0), targetPosition(0), isMoving(false)
@@ -82,7 +85,7 @@ void TMC2209Driver::init() {
     }
 
     // Initialize AccelStepper for movement control
-    stepper = new AccelStepper(AccelStepper::DRIVER, stepPin, dirPin);
+    stepper = new ProfileAccelStepper(AccelStepper::DRIVER, stepPin, dirPin);
     stepper->setMaxSpeed(maxSpeed * microsteps);
     stepper->setAcceleration(acceleration * microsteps);
     stepper->setSpeed(speed * microsteps);
@@ -97,9 +100,9 @@ void TMC2209Driver::init() {
 void TMC2209Driver::move(long steps) {
     if (!tmcDriver || !stepper) return;
 
-    long actualSteps = steps * microsteps;
-    stepper->move(actualSteps);
-    targetPosition = currentPosition + steps;
+    // Positions are in microsteps, the unit the controller plans in
+    stepper->move(steps);
+    targetPosition = stepper->targetPosition();
     isMoving = true;
     enableMotor();
 }
@@ -107,8 +110,7 @@ void TMC2209Driver::move(long steps) {
 void TMC2209Driver::moveTo(long position) {
     if (!tmcDriver || !stepper) return;
 
-    long actualPosition = position * microsteps;
-    stepper->moveTo(actualPosition);
+    stepper->moveTo(position);
     targetPosition = position;
     isMoving = true;
     enableMotor();
@@ -119,13 +121,13 @@ void TMC2209Driver::setCurrentPosition(long position) {
 
     currentPosition = position;
     targetPosition = position;
-    stepper->setCurrentPosition(position * microsteps);
+    stepper->setCurrentPosition(position);
     isMoving = false;
 }
 
 long TMC2209Driver::getCurrentPosition() const {
     if (!stepper) return 0;
-    return stepper->currentPosition() / microsteps;
+    return stepper->currentPosition();
 }
 
 long TMC2209Driver::getTargetPosition() const {
@@ -139,7 +141,7 @@ bool TMC2209Driver::run() {
 
     if (stillRunning) {
         // Update current position
-        currentPosition = stepper->currentPosition() / microsteps;
+        currentPosition = stepper->currentPosition();
 
         // Check for stall detection
         if (tmcDriver && tmcDriver->diag()) {
@@ -201,6 +203,26 @@ void TMC2209Driver::emergencyStop() {
 }
 
 // Speed and acceleration methods
+void TMC2209Driver::stepOnce(int8_t direction) {
+    if (!stepper || !motorEnabled) return;
+
+    stepper->singleStep(direction);
+    currentPosition = stepper->currentPosition();
+}
+
+void IRAM_ATTR TMC2209Driver::timerStep(MotorDriver* driver, int8_t direction, bool coarse) {
+    TMC2209Driver* self = static_cast<TMC2209Driver*>(driver);
+    if (!self->stepper || !self->motorEnabled) return;
+
+    // The pulse AccelStepper's DRIVER mode sends (direction pin inverted
+    // when reversed, 1 us step pulse), written directly
+    isrDigitalWrite(self->dirPin, ((direction > 0) != self->directionReversed) ? HIGH : LOW);
+    isrDigitalWrite(self->stepPin, HIGH);
+    isrDelayMicroseconds(1);
+    isrDigitalWrite(self->stepPin, LOW);
+    self->currentPosition = self->stepper->countStep(direction);
+}
+
 void TMC2209Driver::setSpeed(float speed) {
     this->speed = speed;
     if (stepper) {
@@ -271,6 +293,14 @@ void TMC2209Driver::setMicrosteps(uint16_t microsteps) {
         return;
     }
 
+    // Keep the physical position: positions are counted in microsteps
+    if (stepper) {
+        long position = stepper->currentPosition() * microsteps / this->microsteps;
+        stepper->setCurrentPosition(position);
+        currentPosition = position;
+        targetPosition = position;
+    }
+
     this->microsteps = microsteps;
     if (tmcDriver) {
         tmcDriver->microsteps(microsteps);
@@ -310,6 +340,15 @@ void TMC2209Driver::setCurrent(uint16_t currentMA) {
     Serial.print("Motor current set to: "); Serial.print(currentMA); Serial.println(" mA");
 }
 
+void TMC2209Driver::applyCurrent(uint16_t currentMA) {
+    if (currentMA < MIN_MOTOR_CURRENT) currentMA = MIN_MOTOR_CURRENT;
+    if (currentMA > this->currentMA) currentMA = this->currentMA;
+
+    if (tmcDriver) {
+        tmcDriver->rms_current(currentMA);
+    }
+}
+
 uint16_t TMC2209Driver::getCurrent() const {
     return currentMA;
 }
@@ -365,9 +404,30 @@ int8_t TMC2209Driver::getStallThreshold() const {
     return 0;
 }
 
+bool TMC2209Driver::beginStallDetection() {
+    if (!tmcDriver) return false;
+
+    // StallGuard4 only measures the load in StealthChop: no SpreadCycle at speed
+    tmcDriver->en_spreadCycle(false);
+    tmcDriver->TPWMTHRS(0);
+    tmcDriver->SGTHRS(HOMING_STALL_THRESHOLD);
+    return true;
+}
+
+void TMC2209Driver::endStallDetection() {
+    if (!tmcDriver) return;
+
+    if (stealthChopEnabled) {
+        tmcDriver->TPWMTHRS(STEALTHCHOP_THRESHOLD);
+    } else {
+        tmcDriver->en_spreadCycle(true);
+    }
+}
+
 bool TMC2209Driver::isStallDetected() const {
+    // Same comparison that raises DIAG: SG_RESULT at or below twice SGTHRS
     if (tmcDriver) {
-        return tmcDriver->diag();
+        return tmcDriver->SG_RESULT() <= 2 * (uint16_t)tmcDriver->SGTHRS();
     }
     return false;
 }
@@ -442,19 +502,19 @@ bool TMC2209Driver::checkTMCCommunication() const {
 
 // Helper methods for EEPROM
 void TMC2209Driver::saveConfigToEEPROM() {
-    EEPROM.write(EEPROM_TMC_CONFIG_FLAG, 0xFF);
-    EEPROM.put(EEPROM_TMC_MICROSTEPS, microsteps);
-    EEPROM.put(EEPROM_TMC_CURRENT, currentMA);
-    EEPROM.write(EEPROM_TMC_STEALTHCHOP, stealthChopEnabled ? 1 : 0);
+    EEPROM.write(eepromBase + EEPROM_TMC_CONFIG_FLAG, 0xFF);
+    EEPROM.put(eepromBase + EEPROM_TMC_MICROSTEPS, microsteps);
+    EEPROM.put(eepromBase + EEPROM_TMC_CURRENT, currentMA);
+    EEPROM.write(eepromBase + EEPROM_TMC_STEALTHCHOP, stealthChopEnabled ? 1 : 0);
     EEPROM.commit();
 }
 
 void TMC2209Driver::loadConfigFromEEPROM() {
-    if (EEPROM.read(EEPROM_TMC_CONFIG_FLAG) == 0xFF) {
+    if (EEPROM.read(eepromBase + EEPROM_TMC_CONFIG_FLAG) == 0xFF) {
         uint16_t savedMicrosteps, savedCurrent;
-        EEPROM.get(EEPROM_TMC_MICROSTEPS, savedMicrosteps);
-        EEPROM.get(EEPROM_TMC_CURRENT, savedCurrent);
-        stealthChopEnabled = (EEPROM.read(EEPROM_TMC_STEALTHCHOP) == 1);
+        EEPROM.get(eepromBase + EEPROM_TMC_MICROSTEPS, savedMicrosteps);
+        EEPROM.get(eepromBase + EEPROM_TMC_CURRENT, savedCurrent);
+        stealthChopEnabled = (EEPROM.read(eepromBase + EEPROM_TMC_STEALTHCHOP) == 1);
 
         // Validate loaded values
         if (savedMicrosteps == 1 || savedMicrosteps == 2 || savedMicrosteps == 4 ||
@@ -6,7 +6,7 @@
 #ifdef MOTOR_DRIVER_TMC2209
 #include "../config.h"
 #include <TMCStepper.h>
-#include <AccelStepper.h>
+#include "ProfileAccelStepper.h"
 
 /**
  * TMC2209 Driver implementation for high-performance stepper control
@@ -17,13 +17,14 @@ class TMC2209Driver : public MotorDriver {
 private:
     // TMC2209 driver instance
     TMC2209Stepper* tmcDriver;
-    AccelStepper* stepper;
+    ProfileAccelStepper* stepper;
     HardwareSerial* tmcSerial;
 
     // Pin assignments
     uint8_t stepPin, dirPin, enablePin;
     uint8_t rxPin, txPin;  // UART pins
     uint8_t slaveAddress;
+    uint16_t eepromBase;   // Start of this wheel's EEPROM block
 
     // Motor state
     bool motorEnabled;
@@ -47,6 +48,8 @@ private:
     void saveConfigToEEPROM();
     void loadConfigFromEEPROM();
 
+    static void timerStep(MotorDriver* driver, int8_t direction, bool coarse);
+
 public:
     /**
      * Constructor for TMC2209 driver
@@ -56,9 +59,11 @@ public:
      * @param rxPin UART RX pin for communication
      * @param txPin UART TX pin for communication
      * @param slaveAddr TMC2209 slave address (0-3)
+     * @param eepromBase EEPROM block of the wheel (ConfigManager::getWheelBaseAddress)
      */
     TMC2209Driver(uint8_t stepPin, uint8_t dirPin, uint8_t enablePin,
-                  uint8_t rxPin, uint8_t txPin, uint8_t slaveAddr = 0);
+                  uint8_t rxPin, uint8_t txPin, uint8_t slaveAddr = 0,
+                  uint16_t eepromBase = 0);
 
     // MotorDriver interface implementation
     void init() override;
@@ -73,6 +78,7 @@ public:
     bool isRunning() const override;
     void stop() override;
     void emergencyStop() override;
+    void stepOnce(int8_t direction) override;
 
     void setSpeed(float speed) override;
     void setMaxSpeed(float maxSpeed) override;
@@ -99,7 +105,9 @@ public:
     // TMC2209-specific advanced features
     void setMicrosteps(uint16_t microsteps) override;
     uint16_t getMicrosteps() const override;
+    int getStepsPerRevolution() const override { return MOTOR_STEPS_PER_REV; }
     void setCurrent(uint16_t currentMA) override;
+    void applyCurrent(uint16_t currentMA) override;
     uint16_t getCurrent() const override;
     void setStealthChopEnabled(bool enabled) override;
     bool isStealthChopEnabled() const override;
@@ -109,7 +117,9 @@ public:
     bool isCoolStepEnabled() const;
     void setStallThreshold(int8_t threshold);
     int8_t getStallThreshold() const;
-    bool isStallDetected() const;
+    bool beginStallDetection() override;
+    void endStallDetection() override;
+    bool isStallDetected() const override;
 
     // Diagnostics
     uint32_t getDriverStatus() const;
@@ -127,7 +137,8 @@ public:
 class TMC2209Driver : public MotorDriver {
 public:
     TMC2209Driver(uint8_t stepPin, uint8_t dirPin, uint8_t enablePin,
-                  uint8_t rxPin, uint8_t txPin, uint8_t slaveAddr = 0) {}
+                  uint8_t rxPin, uint8_t txPin, uint8_t slaveAddr = 0,
+                  uint16_t eepromBase = 0) {}
 
     void init() override {}
     void move(long steps) override {}
@@ -140,6 +151,7 @@ public:
     bool isRunning() const override { return false; }
     void stop() override {}
     void emergencyStop() override {}
+    void stepOnce(int8_t direction) override {}
     void setSpeed(float speed) override {}
     void setMaxSpeed(float maxSpeed) override {}
     void setAcceleration(float acceleration) override {}
@@ -1,8 +1,62 @@
 #include "ULN2003Driver.h"
 #include <Arduino.h>
+#include "../config.h"
+#include "../core/Clock.h"
+#include "IsrGpio.h"
+
+#ifdef MOTOR_DRIVER_ULN2003
+static constexpr bool HALF_STEP_APPROACH = ULN2003_HALF_STEP_APPROACH;
+#else
+static constexpr bool HALF_STEP_APPROACH = false;  // Fallback driver: plain full steps
+#endif
+
+// AccelStepper's FULL4WIRE and HALF4WIRE coil patterns (bit i drives
+// coilPins[i]), in RAM for the step interrupt
+static const DRAM_ATTR uint8_t FULL_STEP_PATTERNS[4] = {0b0101, 0b0110, 0b1010, 0b1001};
+static const DRAM_ATTR uint8_t HALF_STEP_PATTERNS[8] = {
+    0b0001, 0b0101, 0b0100, 0b0110, 0b0010, 0b1010, 0b1000, 0b1001
+};
+
+void ULN2003Driver::ApproachStepper::setCoarse(bool enabled) {
+    coarse = enabled;
+    if (!enabled && skipped) {
+        // Stopped between two full steps: energize the half step we are on
+        skipped = false;
+        AccelStepper::step(currentPosition());
+    }
+}
+
+void IRAM_ATTR ULN2003Driver::ApproachStepper::timerStep(int8_t direction, bool coarseStep) {
+    long position = countStep(direction);
+    if (coarseStep && (position & 1) == 0) {
+        skipped = true;
+        return;
+    }
+    skipped = false;
+    writeCoils(position);
+}
+
+void IRAM_ATTR ULN2003Driver::ApproachStepper::writeCoils(long step) {
+    uint8_t mask = HALF_STEP_APPROACH ? HALF_STEP_PATTERNS[step & 7] : FULL_STEP_PATTERNS[step & 3];
+    for (uint8_t i = 0; i < 4; i++) {
+        isrDigitalWrite(coilPins[i], (mask >> i) & 1);
+    }
+}
+
+void ULN2003Driver::ApproachStepper::step(long step) {
+    // Even half steps are the one-coil patterns in between full steps
+    if (coarse && (step & 1) == 0) {
+        skipped = true;
+        return;
+    }
+    skipped = false;
+    AccelStepper::step(step);
+}
 
 ULN2003Driver::ULN2003Driver(uint8_t p1, uint8_t p2, uint8_t p3, uint8_t p4)
-    : stepper(AccelStepper::FULL4WIRE, p1, p3, p2, p4)  // AccelStepper pin order
+    : MotorDriver(&ULN2003Driver::timerStep)
+    , stepper(HALF_STEP_APPROACH ? AccelStepper::HALF4WIRE : AccelStepper::FULL4WIRE,
+              p1, p3, p2, p4)  // AccelStepper pin order
     , motorEnabled(false)
     , directionReversed(false)
     , pin1(p1), pin2(p2), pin3(p3), pin4(p4)
@@ -17,10 +71,10 @@ void ULN2003Driver::init() {
     pinMode(pin4, OUTPUT);
 
     // Initialize stepper with default settings
-    stepper.setMaxSpeed(DEFAULT_MAX_SPEED);
-    stepper.setAcceleration(DEFAULT_ACCELERATION);
+    setMaxSpeed(DEFAULT_MAX_SPEED);
+    setAcceleration(DEFAULT_ACCELERATION);
     // Note: setSpeed() should be called AFTER setMaxSpeed()
-    stepper.setSpeed(DEFAULT_SPEED);
+    setSpeed(DEFAULT_SPEED);
 
     // Start with motor disabled
     disableMotor();
@@ -51,12 +105,12 @@ void ULN2003Driver::setCurrentPosition(long position) {
 }
 
 long ULN2003Driver::getCurrentPosition() const {
-    long pos = const_cast<AccelStepper&>(stepper).currentPosition();
+    long pos = const_cast<ApproachStepper&>(stepper).currentPosition();
     return directionReversed ? -pos : pos;
 }
 
 long ULN2003Driver::getTargetPosition() const {
-    long pos = const_cast<AccelStepper&>(stepper).targetPosition();
+    long pos = const_cast<ApproachStepper&>(stepper).targetPosition();
     return directionReversed ? -pos : pos;
 }
 
@@ -77,7 +131,7 @@ void ULN2003Driver::runToPosition() {
 }
 
 bool ULN2003Driver::isRunning() const {
-    return motorEnabled && const_cast<AccelStepper&>(stepper).isRunning();
+    return motorEnabled && const_cast<ApproachStepper&>(stepper).isRunning();
 }
 
 void ULN2003Driver::stop() {
@@ -90,28 +144,53 @@ void ULN2003Driver::emergencyStop() {
     motorEnabled = false;
 }
 
+void ULN2003Driver::stepOnce(int8_t direction) {
+    if (!motorEnabled) {
+        return;
+    }
+    stepper.singleStep(directionReversed ? -direction : direction);
+}
+
+void IRAM_ATTR ULN2003Driver::timerStep(MotorDriver* driver, int8_t direction, bool coarse) {
+    ULN2003Driver* self = static_cast<ULN2003Driver*>(driver);
+    if (!self->motorEnabled) {
+        return;
+    }
+    self->stepper.timerStep(self->directionReversed ? -direction : direction,
+                            coarse && HALF_STEP_APPROACH);
+}
+
+// Speeds are full steps; the stepper counts half steps in half-step mode
 void ULN2003Driver::setSpeed(float speed) {
-    stepper.setSpeed(speed);
+    stepper.setSpeed(speed * getMicrosteps());
 }
 
 void ULN2003Driver::setMaxSpeed(float maxSpeed) {
-    stepper.setMaxSpeed(maxSpeed);
+    stepper.setMaxSpeed(maxSpeed * getMicrosteps());
 }
 
 void ULN2003Driver::setAcceleration(float acceleration) {
-    stepper.setAcceleration(acceleration);
+    stepper.setAcceleration(acceleration * getMicrosteps());
 }
 
 float ULN2003Driver::getSpeed() const {
-    return const_cast<AccelStepper&>(stepper).speed();
+    return const_cast<ApproachStepper&>(stepper).speed() / getMicrosteps();
 }
 
 float ULN2003Driver::getMaxSpeed() const {
-    return const_cast<AccelStepper&>(stepper).maxSpeed();
+    return const_cast<ApproachStepper&>(stepper).maxSpeed() / getMicrosteps();
 }
 
 float ULN2003Driver::getAcceleration() const {
-    return const_cast<AccelStepper&>(stepper).acceleration();
+    return const_cast<ApproachStepper&>(stepper).acceleration() / getMicrosteps();
+}
+
+uint16_t ULN2003Driver::getMicrosteps() const {
+    return HALF_STEP_APPROACH ? 2 : 1;
+}
+
+void ULN2003Driver::setCoarseStepping(bool coarse) {
+    stepper.setCoarse(coarse && HALF_STEP_APPROACH);
 }
 
 void ULN2003Driver::enableMotor() {
@@ -162,7 +241,7 @@ void ULN2003Driver::stepForward(long steps) {
     // Run to completion immediately (blocking)
     while (stepper.distanceToGo() != 0) {
         stepper.run();
-        delay(1);  // Small delay to prevent watchdog issues
+        Clock::system().delay(1);  // Small delay to prevent watchdog issues
     }
 }
 
@@ -184,6 +263,6 @@ void ULN2003Driver::stepBackward(long steps) {
     // Run to completion immediately (blocking)
     while (stepper.distanceToGo() != 0) {
         stepper.run();
-        delay(1);  // Small delay to prevent watchdog issues
+        Clock::system().delay(1);  // Small delay to prevent watchdog issues
     }
 }
\ No newline at end of file
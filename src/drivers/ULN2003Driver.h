@@ -1,15 +1,48 @@
 #pragma once
 
 #include "MotorDriver.h"
-#include <AccelStepper.h>
+#include "ProfileAccelStepper.h"
 
 /**
  * ULN2003 Driver implementation for 28BYJ-48 stepper motor
  * Supports unipolar stepper motors with 4-wire control
+ *
+ * With ULN2003_HALF_STEP_APPROACH positions count half steps (two
+ * "microsteps" per full step). Coarse stepping then drives only the
+ * two-coil patterns, which are exactly the full-step sequence (half step
+ * 2k+1 = full step k): full torque and speed for travel, half-step
+ * resolution for the final approach, one position count throughout.
  */
 class ULN2003Driver : public MotorDriver {
 private:
-    AccelStepper stepper;
+    /**
+     * AccelStepper that can hold the coils on full-step patterns
+     */
+    class ApproachStepper : public ProfileAccelStepper {
+    public:
+        ApproachStepper(uint8_t interface, uint8_t p1, uint8_t p2, uint8_t p3, uint8_t p4)
+            : ProfileAccelStepper(interface, p1, p2, p3, p4), coilPins{p1, p2, p3, p4} {}
+
+        void setCoarse(bool enabled);
+
+        /**
+         * One step from the step timer interrupt: the library's coil
+         * sequence, written from IRAM
+         */
+        void timerStep(int8_t direction, bool coarseStep);
+
+    protected:
+        void step(long step) override;
+
+    private:
+        uint8_t coilPins[4];    // AccelStepper pin order
+        bool coarse = false;
+        volatile bool skipped = false;   // Last pattern held back in coarse mode
+
+        void writeCoils(long step);
+    };
+
+    ApproachStepper stepper;
     bool motorEnabled;
     bool directionReversed;
 
@@ -22,6 +55,8 @@ private:
     static constexpr float DEFAULT_MAX_SPEED = 500.0;       // steps/second
     static constexpr float DEFAULT_ACCELERATION = 1000.0;   // steps/second² (increased)
 
+    static void timerStep(MotorDriver* driver, int8_t direction, bool coarse);
+
 public:
     /**
      * Constructor for ULN2003 driver
@@ -42,6 +77,7 @@ public:
     bool isRunning() const override;
     void stop() override;
     void emergencyStop() override;
+    void stepOnce(int8_t direction) override;
 
     void setSpeed(float speed) override;
     void setMaxSpeed(float maxSpeed) override;
@@ -58,13 +94,16 @@ public:
     bool isDirectionReversed() const override;
 
     // Capability reporting
-    bool supportsMicrostepping() const override { return false; }
+    bool supportsMicrostepping() const override { return getMicrosteps() > 1; }
     bool supportsStallDetection() const override { return false; }
     bool supportsCoolStep() const override { return false; }
 
     const char* getDriverName() const override { return "ULN2003"; }
     const char* getDriverVersion() const override { return "1.0.0"; }
 
+    uint16_t getMicrosteps() const override;
+    void setCoarseStepping(bool coarse) override;
+
     // ULN2003-specific methods
     void forceAllPinsLow();  // Ensure complete motor shutdown
     void stepForward(long steps) override;
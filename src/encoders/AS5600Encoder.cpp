@@ -1,6 +1,7 @@
 #include "AS5600Encoder.h"
 #include "../config.h"
 #include <Arduino.h>
+#include "../core/Clock.h"
 
 AS5600Encoder::AS5600Encoder(TwoWire* wireInterface)
     : wire(wireInterface)
@@ -13,6 +14,7 @@ AS5600Encoder::AS5600Encoder(TwoWire* wireInterface)
     , rotationDirection(0)
     , readCount(0)
     , errorCount(0)
+    , snapshot()
 {
 }
 
@@ -23,11 +25,11 @@ bool AS5600Encoder::init() {
 
     wire->begin();
 
-    // Test connection to AS5600
+    // Test connection to AS5600 (the snapshot also gives the start angle)
     available = testConnection();
 
     if (available) {
-        lastRawValue = getRawValue();
+        lastRawValue = snapshot.rawAngle;
         previousAngle = lastRawValue;
         resetErrorStats();
     }
@@ -44,7 +46,10 @@ float AS5600Encoder::getAngle() {
     if (rawValue == 0xFFFF) {  // Error reading
         return -1.0f;
     }
+    return processRawAngle(rawValue);
+}
 
+float AS5600Encoder::rawToAngle(uint16_t rawValue) const {
     float angle = rawValue * DEGREES_PER_COUNT;
 
     // Invert encoder direction if configured (compile-time)
@@ -59,7 +64,11 @@ float AS5600Encoder::getAngle() {
         angle = 360.0f - angle;
     }
 
-    angle = normalizeAngle(angle - angleOffset);
+    return normalizeAngle(angle - angleOffset);
+}
+
+float AS5600Encoder::processRawAngle(uint16_t rawValue) {
+    float angle = rawToAngle(rawValue);
 
     // Check for movement and update direction
     int16_t delta = (int16_t)rawValue - (int16_t)previousAngle;
@@ -98,6 +107,14 @@ uint16_t AS5600Encoder::getRawValue() {
     return rawAngle;
 }
 
+uint16_t AS5600Encoder::sampleRawValue() {
+    return readRegister16(AS5600_RAW_ANGLE_H);
+}
+
+float AS5600Encoder::processSample(uint16_t rawValue) {
+    return processRawAngle(rawValue);
+}
+
 void AS5600Encoder::setAngleOffset(float offset) {
     angleOffset = normalizeAngle(offset);
 }
@@ -136,6 +153,21 @@ bool AS5600Encoder::isHealthy() const {
     return isMagnetPositionOK();
 }
 
+bool AS5600Encoder::readStatus(float& angle, uint16_t& rawValue, bool& healthy) {
+    // Angle and magnet status from the same read
+    if (!available || !readSnapshot()) {
+        angle = -1.0f;
+        rawValue = 0xFFFF;
+        healthy = false;
+        return false;
+    }
+
+    rawValue = snapshot.rawAngle;
+    angle = processRawAngle(rawValue);
+    healthy = isHealthy();
+    return true;
+}
+
 bool AS5600Encoder::performSelfTest() {
     if (!available) {
         return false;
@@ -148,7 +180,7 @@ bool AS5600Encoder::performSelfTest() {
         if (readings[i] == 0xFFFF) {
             return false;
         }
-        delay(10);
+        Clock::system().delay(10);
     }
 
     // Test 2: Check that readings are stable (within reasonable range)
@@ -165,15 +197,52 @@ bool AS5600Encoder::performSelfTest() {
     }
 
     // Test 3: Check magnet status
-    if (!isMagnetPositionOK()) {
+    if (!readSnapshot() || !isMagnetPositionOK()) {
         return false;
     }
 
     return true;
 }
 
+bool AS5600Encoder::readSnapshot() const {
+    uint8_t buffer[SNAPSHOT_LENGTH];
+
+    readCount++;
+    snapshot.timestamp = Clock::system().millis();
+    snapshot.attempted = true;
+    if (!readRegisters(AS5600_STATUS, buffer, SNAPSHOT_LENGTH)) {
+        // Retried once the failure is maxAge old, not on every call
+        errorCount++;
+        snapshot.valid = false;
+        return false;
+    }
+
+    // Offsets from STATUS; the 16-bit registers are big-endian, 12 bits used
+    snapshot.status = buffer[0];
+    snapshot.rawAngle = ((buffer[AS5600_RAW_ANGLE_H - AS5600_STATUS] << 8) |
+                         buffer[AS5600_RAW_ANGLE_L - AS5600_STATUS]) & 0x0FFF;
+    snapshot.angle = ((buffer[AS5600_ANGLE_H - AS5600_STATUS] << 8) |
+                      buffer[AS5600_ANGLE_L - AS5600_STATUS]) & 0x0FFF;
+    snapshot.agc = buffer[AS5600_AGC - AS5600_STATUS];
+    snapshot.magnitude = ((buffer[AS5600_MAGNITUDE_H - AS5600_STATUS] << 8) |
+                          buffer[AS5600_MAGNITUDE_L - AS5600_STATUS]) & 0x0FFF;
+    snapshot.valid = true;
+    return true;
+}
+
+const AS5600Encoder::Snapshot& AS5600Encoder::getSnapshot(unsigned long maxAgeMs) const {
+    if (!snapshot.attempted || Clock::system().millis() - snapshot.timestamp > maxAgeMs) {
+        readSnapshot();
+    }
+    return snapshot;
+}
+
 uint8_t AS5600Encoder::getMagnetStatus() const {
-    uint8_t status = readRegister8(AS5600_STATUS);
+    const Snapshot& current = getSnapshot(AS5600_SNAPSHOT_MAX_AGE);
+    if (!current.valid) {
+        return 3;  // Sensor not answering: treat as no magnet
+    }
+    uint8_t status = current.status;
 
     if (!(status & AS5600_STATUS_MD)) {
         return 3;  // No magnet detected
@@ -189,11 +258,13 @@ uint8_t AS5600Encoder::getMagnetStatus() const {
 }
 
 uint8_t AS5600Encoder::getAGC() {
-    return readRegister8(AS5600_AGC);
+    const Snapshot& current = getSnapshot(AS5600_SNAPSHOT_MAX_AGE);
+    return current.valid ? current.agc : 0xFF;
 }
 
 uint16_t AS5600Encoder::getMagnitude() {
-    return readRegister16(AS5600_MAGNITUDE_H);
+    const Snapshot& current = getSnapshot(AS5600_SNAPSHOT_MAX_AGE);
+    return current.valid ? current.magnitude : 0xFFFF;
 }
 
 bool AS5600Encoder::isMagnetPositionOK() const {
@@ -216,7 +287,7 @@ void AS5600Encoder::resetErrorStats() {
 uint16_t AS5600Encoder::readRegister16(uint8_t reg) const {
     wire->beginTransmission(AS5600_ADDRESS);
     wire->write(reg);
-    if (wire->endTransmission() != 0) {
+    if (wire->endTransmission(false) != 0) {  // Repeated start: one locked transaction
         return 0xFFFF;  // Error
     }
 
@@ -233,7 +304,7 @@ uint16_t AS5600Encoder::readRegister16(uint8_t reg) const {
 uint8_t AS5600Encoder::readRegister8(uint8_t reg) const {
     wire->beginTransmission(AS5600_ADDRESS);
     wire->write(reg);
-    if (wire->endTransmission() != 0) {
+    if (wire->endTransmission(false) != 0) {  // Repeated start: one locked transaction
         return 0xFF;  // Error
     }
 
@@ -245,10 +316,29 @@ uint8_t AS5600Encoder::readRegister8(uint8_t reg) const {
     return 0xFF;  // Error
 }
 
+bool AS5600Encoder::readRegisters(uint8_t reg, uint8_t* buffer, uint8_t length) const {
+    wire->beginTransmission(AS5600_ADDRESS);
+    wire->write(reg);
+    if (wire->endTransmission(false) != 0) {  // Repeated start: one locked transaction
+        return false;
+    }
+
+    // The address pointer auto-increments through the block; the no-increment
+    // rule of the angle and magnitude registers only applies when the pointer
+    // is set to their high byte directly
+    wire->requestFrom(AS5600_ADDRESS, length);
+    if (wire->available() != length) {
+        return false;
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        buffer[i] = wire->read();
+    }
+    return true;
+}
+
 bool AS5600Encoder::testConnection() {
-    // Try to read the status register
-    uint8_t status = readRegister8(AS5600_STATUS);
-    return status != 0xFF;  // 0xFF indicates communication error
+    // Try to read the status registers
+    return readSnapshot();
 }
 
 float AS5600Encoder::normalizeAngle(float angle) {
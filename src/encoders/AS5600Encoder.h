@@ -21,6 +21,9 @@ private:
     static constexpr uint8_t AS5600_MAGNITUDE_H = 0x1B;
     static constexpr uint8_t AS5600_MAGNITUDE_L = 0x1C;
 
+    // Burst read from STATUS to MAGNITUDE_L (0x10-0x19 are skipped over)
+    static constexpr uint8_t SNAPSHOT_LENGTH = AS5600_MAGNITUDE_L - AS5600_STATUS + 1;
+
     // Status register bits
     static constexpr uint8_t AS5600_STATUS_MH = 0x08;  // Magnet too strong
     static constexpr uint8_t AS5600_STATUS_ML = 0x10;  // Magnet too weak
@@ -37,9 +40,9 @@ private:
     uint16_t previousAngle;
     int8_t rotationDirection;  // 1 = CW, -1 = CCW, 0 = no movement
 
-    // Performance tracking
-    uint32_t readCount;
-    uint32_t errorCount;
+    // Performance tracking (also counted by const status queries)
+    mutable uint32_t readCount;
+    mutable uint32_t errorCount;
 
     static constexpr uint16_t RESOLUTION = 4096;  // 12-bit resolution
     static constexpr float DEGREES_PER_COUNT = 360.0f / RESOLUTION;
@@ -56,6 +59,9 @@ public:
     bool isAvailable() const override;
     float getAngle() override;
     uint16_t getRawValue() override;
+    float rawToAngle(uint16_t rawValue) const override;
+    uint16_t sampleRawValue() override;
+    float processSample(uint16_t rawValue) override;
     void setAngleOffset(float offset) override;
     float getAngleOffset() const override;
     uint16_t getResolution() const override;
@@ -63,23 +69,51 @@ public:
     bool hasMovementDetected() override;
     void resetMovementDetection() override;
     bool isHealthy() const override;
+    bool readStatus(float& angle, uint16_t& rawValue, bool& healthy) override;
     bool performSelfTest() override;
 
     // AS5600-specific methods
 
     /**
-     * Get magnet status
+     * Registers captured by one burst read
+     */
+    struct Snapshot {
+        uint8_t status;             // STATUS (MD/ML/MH bits)
+        uint16_t rawAngle;          // RAW_ANGLE, 12 bits
+        uint16_t angle;             // ANGLE (ZPOS/MPOS scaled), 12 bits
+        uint8_t agc;                // Automatic gain control
+        uint16_t magnitude;         // CORDIC magnitude, 12 bits
+        unsigned long timestamp;    // Clock millis() of the last read attempt
+        bool attempted;             // A read has been tried
+        bool valid;                 // The last read succeeded
+    };
+
+    /**
+     * Read STATUS, RAW_ANGLE, ANGLE, AGC and MAGNITUDE in one I2C
+     * transaction and cache them
+     * @return true if the read succeeded (a failure marks the cache invalid,
+     *         so a sensor that drops out is not reported healthy)
+     */
+    bool readSnapshot() const;
+
+    /**
+     * Cached snapshot, re-read first if older than maxAgeMs
+     */
+    const Snapshot& getSnapshot(unsigned long maxAgeMs) const;
+
+    /**
+     * Get magnet status (from the snapshot)
      * @return 0=OK, 1=too weak, 2=too strong, 3=not detected
      */
     uint8_t getMagnetStatus() const;
 
     /**
-     * Get automatic gain control value
+     * Get automatic gain control value (from the snapshot)
      */
     uint8_t getAGC();
 
     /**
-     * Get magnetic field magnitude
+     * Get magnetic field magnitude (from the snapshot)
      */
     uint16_t getMagnitude();
 
@@ -130,6 +164,8 @@ public:
     bool isDirectionInverted() const;
 
 private:
+    mutable Snapshot snapshot;  // Last good burst read
+
     /**
      * Read 16-bit value from AS5600 register
      */
@@ -140,6 +176,17 @@ private:
      */
     uint8_t readRegister8(uint8_t reg) const;
 
+    /**
+     * Read consecutive registers in one transaction
+     * @return true if all bytes arrived
+     */
+    bool readRegisters(uint8_t reg, uint8_t* buffer, uint8_t length) const;
+
+    /**
+     * Angle of a raw reading, with movement/direction tracking
+     */
+    float processRawAngle(uint16_t rawValue);
+
     /**
      * Check if AS5600 is responding
      */
@@ -148,5 +195,5 @@ private:
     /**
      * Normalize angle to 0-360 range
      */
-    float normalizeAngle(float angle);
+    static float normalizeAngle(float angle);
 };
\ No newline at end of file
@@ -32,6 +32,25 @@ public:
      */
     virtual uint16_t getRawValue() = 0;
 
+    /**
+     * Angle (0-360) for a raw value, with the same inversion and offset as
+     * getAngle() but no bus access or movement tracking
+     */
+    virtual float rawToAngle(uint16_t rawValue) const = 0;
+
+    /**
+     * Raw value straight from the sensor, without touching read counters or
+     * movement tracking (safe from a sampling task)
+     * @return Raw value, or 0xFFFF on error
+     */
+    virtual uint16_t sampleRawValue() = 0;
+
+    /**
+     * Angle of a raw value taken with sampleRawValue(), with the same
+     * movement tracking as getAngle() (call from the encoder's owner)
+     */
+    virtual float processSample(uint16_t rawValue) = 0;
+
     /**
      * Set angle offset for calibration
      */
@@ -67,6 +86,18 @@ public:
      */
     virtual bool isHealthy() const = 0;
 
+    /**
+     * Angle, raw value and health for diagnostics; encoders that can
+     * read them together override this to save bus round trips
+     * @return false if the angle could not be read
+     */
+    virtual bool readStatus(float& angle, uint16_t& rawValue, bool& healthy) {
+        angle = getAngle();
+        rawValue = getRawValue();
+        healthy = isHealthy();
+        return angle >= 0.0f;
+    }
+
     /**
      * Perform encoder self-test
      */
@@ -0,0 +1,162 @@
+#include "EncoderSampler.h"
+#include "../core/Clock.h"
+
+EncoderSampler::EncoderSampler(EncoderInterface* encoder, uint32_t intervalMs, uint32_t idleIntervalMs)
+    : encoder(encoder)
+    , intervalMs(intervalMs > 0 ? intervalMs : 1)
+    , idleIntervalMs(idleIntervalMs > intervalMs ? idleIntervalMs : this->intervalMs)
+    , lastSampleMs(0)
+    , sampledOnce(false)
+    , published(0)
+    , active(false)
+#if defined(ESP32) && !defined(ARDUINO_HOST)
+    , task(nullptr)
+    , stopRequested(false)
+    , taskStopped(false)
+#endif
+{
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+        slots[i].sequence.store(0, std::memory_order_relaxed);
+        slots[i].timestamp.store(0, std::memory_order_relaxed);
+        slots[i].raw.store(0, std::memory_order_relaxed);
+    }
+}
+
+EncoderSampler::~EncoderSampler() {
+    #if defined(ESP32) && !defined(ARDUINO_HOST)
+    if (task) {
+        // Let the task finish its read and delete itself: killing it from
+        // here could leave the Wire lock taken
+        stopRequested.store(true, std::memory_order_release);
+        xTaskNotifyGive(task);
+        while (!taskStopped.load(std::memory_order_acquire)) {
+            vTaskDelay(1);
+        }
+        task = nullptr;
+    }
+    #endif
+}
+
+bool EncoderSampler::start() {
+    #if defined(ESP32) && !defined(ARDUINO_HOST)
+    if (!task) {
+        // Above the Arduino loop task (priority 1), so samples stay on time
+        if (xTaskCreate(&EncoderSampler::taskEntry, "enc_sampler", 3072, this, 2, &task) != pdPASS) {
+            task = nullptr;
+        }
+    }
+    #endif
+    return isBackground();
+}
+
+bool EncoderSampler::isBackground() const {
+    #if defined(ESP32) && !defined(ARDUINO_HOST)
+    return task != nullptr;
+    #else
+    return false;
+    #endif
+}
+
+#if defined(ESP32) && !defined(ARDUINO_HOST)
+void EncoderSampler::taskEntry(void* context) {
+    EncoderSampler* self = static_cast<EncoderSampler*>(context);
+    TickType_t lastWake = xTaskGetTickCount();
+    TickType_t period = pdMS_TO_TICKS(self->intervalMs);
+    TickType_t idlePeriod = pdMS_TO_TICKS(self->idleIntervalMs);
+    if (period == 0) period = 1;
+    if (idlePeriod < period) idlePeriod = period;
+
+    while (!self->stopRequested.load(std::memory_order_acquire)) {
+        self->sample();
+        if (self->active.load(std::memory_order_acquire)) {
+            vTaskDelayUntil(&lastWake, period);
+        } else {
+            // Idle wheel: slow rate, woken early by setActive(true) or the destructor
+            ulTaskNotifyTake(pdTRUE, idlePeriod);
+            lastWake = xTaskGetTickCount();
+        }
+    }
+
+    self->taskStopped.store(true, std::memory_order_release);
+    vTaskDelete(nullptr);
+}
+#endif
+
+void EncoderSampler::setActive(bool enable) {
+    if (active.load(std::memory_order_relaxed) == enable) {
+        return;
+    }
+    active.store(enable, std::memory_order_release);
+    #if defined(ESP32) && !defined(ARDUINO_HOST)
+    if (enable && task) {
+        xTaskNotifyGive(task);
+    }
+    #endif
+}
+
+void EncoderSampler::poll() {
+    if (isBackground()) {
+        return;
+    }
+
+    unsigned long now = Clock::system().millis();
+    uint32_t interval = active.load(std::memory_order_relaxed) ? intervalMs : idleIntervalMs;
+    if (sampledOnce && now - lastSampleMs < interval) {
+        return;
+    }
+    lastSampleMs = now;
+    sampledOnce = true;
+    sample();
+}
+
+void EncoderSampler::sample() {
+    if (!encoder || !encoder->isAvailable()) {
+        return;
+    }
+
+    uint16_t raw = encoder->sampleRawValue();
+    if (raw == 0xFFFF) {
+        return;
+    }
+    uint32_t timestamp = Clock::system().micros();
+
+    // Single producer: plain load/store of our own counter is enough
+    uint32_t index = published.load(std::memory_order_relaxed);
+    Slot& slot = slots[index & (CAPACITY - 1)];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);   // Odd sequence before the data
+    slot.timestamp.store(timestamp, std::memory_order_relaxed);
+    slot.raw.store(raw, std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    published.store(index + 1, std::memory_order_release);
+}
+
+bool EncoderSampler::readSlot(uint32_t index, Sample& sample) const {
+    const Slot& slot = slots[index & (CAPACITY - 1)];
+    uint32_t expected = 2 * index + 2;
+
+    if (slot.sequence.load(std::memory_order_acquire) != expected) {
+        return false;  // Being rewritten, or already overwritten
+    }
+    sample.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+    sample.raw = slot.raw.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);    // Data before the re-check
+
+    return slot.sequence.load(std::memory_order_relaxed) == expected;
+}
+
+bool EncoderSampler::getLatest(Sample& sample, uint32_t maxAgeMicros) const {
+    // The latest slot is only rewritten CAPACITY samples later; retry in
+    // case the reader was preempted for that long
+    for (uint8_t attempt = 0; attempt < 3; attempt++) {
+        uint32_t count = published.load(std::memory_order_acquire);
+        if (count == 0) {
+            return false;
+        }
+        if (readSlot(count - 1, sample)) {
+            return Clock::system().micros() - sample.timestamp <= maxAgeMicros;
+        }
+    }
+    return false;
+}
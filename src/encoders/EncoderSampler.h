@@ -0,0 +1,113 @@
+#pragma once
+
+#include "EncoderInterface.h"
+#include <stdint.h>
+#include <atomic>
+
+#if defined(ESP32) && !defined(ARDUINO_HOST)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+/**
+ * Reads the encoder at a fixed rate into a ring of timestamped raw samples
+ *
+ * On the ESP32 a FreeRTOS task does the I2C reads; elsewhere (host builds,
+ * or if the task cannot be created) poll() samples from the main loop.
+ * Readers take the latest sample without touching the bus, so status
+ * queries cost no I2C traffic and the bus load is bounded by the sample
+ * rate whatever the number of readers. While the owner keeps it active
+ * (wheel moving or settling) samples come at the full rate, otherwise at
+ * the slower idle rate.
+ *
+ * The task reads through EncoderInterface::sampleRawValue(), which leaves
+ * the encoder's counters and movement tracking alone: those stay with the
+ * main loop, which feeds samples back with processSample().
+ *
+ * One producer, any number of readers, no locks. Each slot carries a
+ * sequence number that is odd while the producer rewrites it; a reader
+ * copies the slot and keeps the copy only if the sequence still matches
+ * the sample it wanted (seqlock). Only atomic loads, stores and fences are
+ * used: the ESP32-C3 (RV32IMC) has no atomic read-modify-write.
+ */
+class EncoderSampler {
+public:
+    static constexpr uint8_t CAPACITY = 32;     // Power of two
+
+    struct Sample {
+        uint32_t timestamp;     // Clock micros() of the read
+        uint16_t raw;           // Raw encoder counts
+    };
+
+    /**
+     * @param encoder Encoder to sample (must outlive the sampler)
+     * @param intervalMs Time between samples while active
+     * @param idleIntervalMs Time between samples while inactive
+     */
+    EncoderSampler(EncoderInterface* encoder, uint32_t intervalMs, uint32_t idleIntervalMs);
+
+    /**
+     * Stops the task after its current read, so it never dies holding the bus
+     */
+    ~EncoderSampler();
+
+    /**
+     * Start the sampling task where there is one
+     * @return true if a task samples in the background (false: call poll())
+     */
+    bool start();
+
+    /**
+     * Sample at the full (true) or the idle rate (false); starts inactive
+     */
+    void setActive(bool active);
+    bool isActive() const { return active.load(std::memory_order_relaxed); }
+
+    /**
+     * Take a sample if one is due (no-op while the task runs)
+     */
+    void poll();
+
+    bool isBackground() const;
+    uint32_t getInterval() const { return intervalMs; }
+
+    /**
+     * Latest sample
+     * @param maxAgeMicros Reject a sample older than this
+     * @return false if there is no sample that recent
+     */
+    bool getLatest(Sample& sample, uint32_t maxAgeMicros) const;
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence;     // 2n+1 while writing sample n, 2n+2 once written
+        std::atomic<uint32_t> timestamp;
+        std::atomic<uint16_t> raw;
+    };
+
+    EncoderInterface* encoder;
+    uint32_t intervalMs;
+    uint32_t idleIntervalMs;
+    unsigned long lastSampleMs;
+    bool sampledOnce;
+    Slot slots[CAPACITY];
+    std::atomic<uint32_t> published;        // Samples written (only the producer stores)
+    std::atomic<bool> active;
+
+    #if defined(ESP32) && !defined(ARDUINO_HOST)
+    TaskHandle_t task;
+    std::atomic<bool> stopRequested;
+    std::atomic<bool> taskStopped;
+    static void taskEntry(void* context);
+    #endif
+
+    /**
+     * Read the encoder and publish the sample (producer side)
+     */
+    void sample();
+
+    /**
+     * Copy sample number index if it is still in the ring
+     */
+    bool readSlot(uint32_t index, Sample& sample) const;
+};
@@ -1,12 +1,25 @@
 #include <Arduino.h>
-#include "core/FilterWheelController.h"
+#include "core/MultiWheelController.h"
+#include "config/ConfigManager.h"
 #include "config.h"
 
+#ifdef ARDUINO_HOST
+#include "simulation/FilterWheelSimulator.h"
+#include "simulation/SimulatedMotorDriver.h"
+#include "simulation/SimulatedEncoder.h"
+#include "simulation/SimulatedStepTimer.h"
+#endif
+
 // ============================================
-// MAIN FILTER WHEEL CONTROLLER
+// FILTER WHEEL CONTROLLERS (one per wheel)
 // ============================================
 
-FilterWheelController controller;
+MultiWheelController wheels;
+
+#ifdef ARDUINO_HOST
+// Host build: the wheels, motors and encoders are simulated
+FilterWheelSimulator simulators[WHEEL_COUNT];
+#endif
 
 // ============================================
 // ARDUINO SETUP
@@ -45,7 +58,44 @@ void setup() {
         #error "No motor driver selected! Please define one in config.h"
     #endif
 
-    if (!controller.init(driverType)) {
+    #ifdef ARDUINO_HOST
+        Serial.println("Host build: using simulated mechanism");
+        // Wall-clock host: the timer callback is serviced from the loop
+        wheels.setStepTimer(std::unique_ptr<StepTimer>(new SimulatedStepTimer()));
+        bool initialized = true;
+        for (uint8_t i = 0; i < WHEEL_COUNT && initialized; i++) {
+            std::unique_ptr<MotorDriver> simDriver(new SimulatedMotorDriver(simulators[i]));
+            simDriver->init();
+            initialized = (wheels.addWheel(std::move(simDriver),
+                                           std::unique_ptr<EncoderInterface>(new SimulatedEncoder(simulators[i]))) != 0);
+        }
+        (void)driverType;
+    #else
+        bool initialized = (wheels.addWheel(driverType) != 0);
+
+        #if WHEEL_COUNT > 1
+        // Extra wheels: TMC2209s on the same UART, at the addresses wheel 1
+        // (TMC_DRIVER_ADDRESS) leaves free, in ascending order
+        const uint8_t stepPins[] = EXTRA_WHEEL_STEP_PINS;
+        const uint8_t dirPins[] = EXTRA_WHEEL_DIR_PINS;
+        const uint8_t enablePins[] = EXTRA_WHEEL_ENABLE_PINS;
+        for (uint8_t i = 1; i < WHEEL_COUNT && initialized; i++) {
+            TMC2209Config config;
+            config.stepPin = stepPins[i - 1];
+            config.dirPin = dirPins[i - 1];
+            config.enablePin = enablePins[i - 1];
+            config.rxPin = MOTOR_RX_PIN;
+            config.txPin = MOTOR_TX_PIN;
+            config.slaveAddress = (i - 1 < TMC_DRIVER_ADDRESS) ? i - 1 : i;
+            config.eepromBase = ConfigManager::getWheelBaseAddress(i);
+            std::unique_ptr<MotorDriver> driver = MotorDriverFactory::createTMC2209Driver(config);
+            driver->init();
+            initialized = (wheels.addWheel(std::move(driver), nullptr) != 0);
+        }
+        #endif
+    #endif
+
+    if (!initialized) {
         Serial.println("ERROR: Failed to initialize filter wheel controller!");
         Serial.println("Check hardware connections and restart.");
         while(1) {
@@ -53,13 +103,15 @@ void setup() {
         }
     }
 
-    Serial.println("Filter wheel controller initialized successfully.");
+    Serial.print("Filter wheel controller initialized successfully (");
+    Serial.print(wheels.getWheelCount());
+    Serial.println(wheels.getWheelCount() == 1 ? " wheel)." : " wheels, address with #N:).");
     Serial.println("System ready for commands.");
     Serial.println("Type #HELP for available commands.");
     Serial.println();
 
     // Show system status
-    Serial.println(controller.getSystemStatus());
+    Serial.println(wheels.getWheel(1)->getSystemStatus());
     Serial.println();
 }
 
@@ -68,11 +120,11 @@ void setup() {
 // ============================================
 
 void loop() {
-    // Update controller (handles motor movement, display, power management)
-    controller.update();
+    // Update every wheel (handles motor movement, display, power management)
+    wheels.update();
 
-    // Handle serial commands
-    controller.handleSerial();
+    // Handle serial commands (routed to the addressed wheel)
+    wheels.handleSerial();
 
     // Small delay to prevent excessive CPU usage
     delay(1);
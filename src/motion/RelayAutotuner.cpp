@@ -0,0 +1,111 @@
+#include "RelayAutotuner.h"
+#include <math.h>
+
+RelayAutotuner::RelayAutotuner()
+    : relaySteps(0)
+    , hysteresis(0.0f)
+    , cyclesWanted(0)
+    , output(0)
+    , iterations(0)
+    , switches(0)
+    , firstSwitchIteration(0)
+    , lastSwitchIteration(0)
+    , halfCyclePeak(0.0f)
+    , peakSum(0.0f)
+    , peakCount(0)
+    , complete(false)
+{
+}
+
+void RelayAutotuner::begin(long steps, float band, uint8_t cycles) {
+    relaySteps = (steps > 0) ? steps : -steps;
+    hysteresis = band;
+    cyclesWanted = (cycles > 0) ? cycles : 1;
+    output = 0;
+    iterations = 0;
+    switches = 0;
+    firstSwitchIteration = 0;
+    lastSwitchIteration = 0;
+    halfCyclePeak = 0.0f;
+    peakSum = 0.0f;
+    peakCount = 0;
+    complete = false;
+}
+
+long RelayAutotuner::update(float error) {
+    if (complete) {
+        return 0;
+    }
+    iterations++;
+
+    // First call: kick towards the error (or forward when on the setpoint)
+    if (output == 0) {
+        output = (error < 0) ? -1 : 1;
+        return output * relaySteps;
+    }
+
+    if (fabsf(error) > halfCyclePeak) {
+        halfCyclePeak = fabsf(error);
+    }
+
+    int8_t next = output;
+    if (error > hysteresis) {
+        next = 1;
+    } else if (error < -hysteresis) {
+        next = -1;
+    }
+
+    if (next != output) {
+        switches++;
+        if (switches == 1) {
+            // Transient from the rest position ends here
+            firstSwitchIteration = iterations;
+        } else {
+            peakSum += halfCyclePeak;
+            peakCount++;
+        }
+        lastSwitchIteration = iterations;
+        halfCyclePeak = 0.0f;
+        output = next;
+
+        if (switches > 2 * cyclesWanted) {
+            complete = true;
+            return 0;
+        }
+    }
+
+    return output * relaySteps;
+}
+
+float RelayAutotuner::getAmplitude() const {
+    return (peakCount > 0) ? peakSum / peakCount : 0.0f;
+}
+
+float RelayAutotuner::getUltimateGain() const {
+    float amplitude = getAmplitude();
+    if (amplitude <= 0.0f) {
+        return 0.0f;
+    }
+    return 4.0f * relaySteps / ((float)M_PI * amplitude);
+}
+
+float RelayAutotuner::getUltimatePeriod() const {
+    if (switches < 2) {
+        return 0.0f;
+    }
+    // Two switches per period
+    return 2.0f * (lastSwitchIteration - firstSwitchIteration) / (switches - 1);
+}
+
+float RelayAutotuner::getProportionalGain() const {
+    float ku = getUltimateGain();
+    float tu = getUltimatePeriod();
+    if (!complete || ku <= 0.0f || tu <= 0.0f) {
+        return 0.0f;
+    }
+
+    // 0.7 Ku = 0.89 of the plant gain at the minimum period of 4 iterations
+    float lag = tu / 4.0f;
+    if (lag < 1.0f) lag = 1.0f;
+    return 0.7f * ku / lag;
+}
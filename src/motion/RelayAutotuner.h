@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Relay feedback (Åström-Hägglund) tuning of the iterative angle PID
+ *
+ * The PID runs one move per iteration, so the experiment does the same:
+ * after each settled encoder read the relay commands a fixed move towards
+ * the setpoint (sign of the error, with hysteresis against encoder noise).
+ * The wheel then oscillates around the setpoint; from the amplitude a
+ * (degrees) and period Tu (iterations) of that oscillation the ultimate
+ * gain is Ku = 4h / (pi a) steps per degree.
+ *
+ * Seen per iteration the wheel is an integrating process: each move adds
+ * to the angle. For such a plant the relay puts the wheel's own gain at
+ * pi Ku / 4 steps per degree and its lag at Tu / 4 iterations; classic
+ * Ziegler-Nichols integral and derivative terms keep it oscillating, so
+ * only the proportional gain is derived here.
+ */
+class RelayAutotuner {
+public:
+    RelayAutotuner();
+
+    /**
+     * Start a new experiment
+     * @param relaySteps Relay output h (steps per iteration)
+     * @param hysteresis Error band in which the relay keeps its output (degrees)
+     * @param cycles Full oscillation cycles to average (after one settling cycle)
+     */
+    void begin(long relaySteps, float hysteresis, uint8_t cycles);
+
+    /**
+     * Feed the settled error of the last iteration
+     * @return Next move in steps, 0 once the experiment is complete
+     */
+    long update(float error);
+
+    bool isComplete() const { return complete; }
+    uint16_t getIterations() const { return iterations; }
+
+    /**
+     * Oscillation results (valid once complete)
+     */
+    float getAmplitude() const;
+    float getUltimateGain() const;
+    float getUltimatePeriod() const;
+
+    /**
+     * Proportional gain (steps per degree) that corrects about 90% of the
+     * error per iteration, less when the wheel lags (0 until complete)
+     */
+    float getProportionalGain() const;
+
+private:
+    long relaySteps;
+    float hysteresis;
+    uint8_t cyclesWanted;
+
+    int8_t output;              // Current relay sign
+    uint16_t iterations;
+    uint8_t switches;           // Relay sign changes so far
+    uint16_t firstSwitchIteration;
+    uint16_t lastSwitchIteration;
+    float halfCyclePeak;        // Largest |error| since the last switch
+    float peakSum;              // Sum of half-cycle peaks (after the first switch)
+    uint8_t peakCount;
+    bool complete;
+};
@@ -0,0 +1,98 @@
+#include "RevolutionCalibration.h"
+#include <math.h>
+
+RevolutionCalibration::RevolutionCalibration()
+    : count(0)
+    , firstPosition(0)
+    , endAngle(0.0f)
+    , endSteps(0.0f)
+    , startAngle(0.0f)
+    , rawAngle(0.0f)
+    , unwrappedAngle(0.0f)
+    , lastSteps(0)
+    , complete(false)
+{
+}
+
+void RevolutionCalibration::begin(float angle, long steps, const float* positionAngles,
+                                  uint8_t positionCount, float leadAngle) {
+    count = (positionCount > MAX_POSITIONS) ? MAX_POSITIONS : positionCount;
+    startAngle = angle;
+    rawAngle = angle;
+    unwrappedAngle = angle;
+    lastSteps = steps;
+    complete = false;
+
+    // Each position is recorded at its first occurrence past the lead angle
+    float earliest = angle + leadAngle;
+    firstPosition = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        float target = positionAngles[i];
+        target += 360.0f * ceilf((earliest - target) / 360.0f);
+        crossAngle[i] = target;
+        crossSteps[i] = 0.0f;
+        crossed[i] = false;
+        if (target < crossAngle[firstPosition]) {
+            firstPosition = i;
+        }
+    }
+    endAngle = crossAngle[firstPosition] + 360.0f;
+    endSteps = 0.0f;
+}
+
+bool RevolutionCalibration::addSample(float angle, long steps) {
+    if (complete || count == 0) {
+        return complete;
+    }
+
+    // Unwrap: the wheel moves far less than half a turn between samples
+    float delta = angle - rawAngle;
+    while (delta > 180.0f) delta -= 360.0f;
+    while (delta < -180.0f) delta += 360.0f;
+    rawAngle = angle;
+
+    float previousAngle = unwrappedAngle;
+    long previousSteps = lastSteps;
+    unwrappedAngle += delta;
+    lastSteps = steps;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (!crossed[i]) {
+            crossed[i] = crossing(crossAngle[i], previousAngle, previousSteps, steps, crossSteps[i]);
+        }
+    }
+
+    complete = crossing(endAngle, previousAngle, previousSteps, steps, endSteps);
+    return complete;
+}
+
+bool RevolutionCalibration::crossing(float target, float previousAngle, long previousSteps,
+                                     long steps, float& stepsAtTarget) const {
+    if (unwrappedAngle <= previousAngle || previousAngle >= target || unwrappedAngle < target) {
+        return false;
+    }
+
+    float fraction = (target - previousAngle) / (unwrappedAngle - previousAngle);
+    stepsAtTarget = previousSteps + fraction * (steps - previousSteps);
+    return true;
+}
+
+long RevolutionCalibration::getStepsPerRevolution() const {
+    if (!complete) {
+        return 0;
+    }
+    return lroundf(endSteps - crossSteps[firstPosition]);
+}
+
+bool RevolutionCalibration::getPositionSteps(uint16_t* offsets) const {
+    long stepsPerRevolution = getStepsPerRevolution();
+    if (stepsPerRevolution <= 0) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        long offset = lroundf(crossSteps[i] - crossSteps[0]);
+        offsets[i] = (uint16_t)(((offset % stepsPerRevolution) + stepsPerRevolution) % stepsPerRevolution);
+    }
+    return true;
+}
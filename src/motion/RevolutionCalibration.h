@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Learns steps per revolution and the step offset of each filter position
+ * from encoder samples taken while the wheel turns forward
+ *
+ * Each position is recorded where the unwrapped encoder angle first crosses
+ * it (interpolated between samples), once the wheel has travelled the lead
+ * angle so gear play is taken up. Steps per revolution is the distance
+ * between the first crossing and the same angle one turn later. Every
+ * crossing is taken at the same speed and direction, so encoder lag and
+ * backlash cancel out of the differences.
+ */
+class RevolutionCalibration {
+public:
+    static constexpr uint8_t MAX_POSITIONS = 9;
+
+    RevolutionCalibration();
+
+    /**
+     * Start recording
+     * @param startAngle Encoder angle before the wheel moves (degrees)
+     * @param startSteps Driver position at startAngle
+     * @param positionAngles Angle of each filter position (degrees)
+     * @param count Number of positions
+     * @param leadAngle Wheel travel before crossings are recorded (degrees)
+     */
+    void begin(float startAngle, long startSteps, const float* positionAngles,
+               uint8_t count, float leadAngle);
+
+    /**
+     * Add a sample taken while moving forward
+     * @return true once a full revolution past the first crossing was seen
+     */
+    bool addSample(float angle, long steps);
+
+    bool isComplete() const { return complete; }
+
+    /**
+     * Wheel travel since begin() (degrees, unwrapped)
+     */
+    float getTravel() const { return unwrappedAngle - startAngle; }
+
+    /**
+     * Measured steps per revolution (0 until complete)
+     */
+    long getStepsPerRevolution() const;
+
+    /**
+     * Forward steps from position 1 to each position
+     * @param offsets Output array (at least count entries)
+     * @return false until complete
+     */
+    bool getPositionSteps(uint16_t* offsets) const;
+
+private:
+    uint8_t count;
+    float crossAngle[MAX_POSITIONS];    // Unwrapped angle recorded for each position
+    float crossSteps[MAX_POSITIONS];    // Driver position at the crossing
+    bool crossed[MAX_POSITIONS];
+    uint8_t firstPosition;              // Index of the position crossed first
+    float endAngle;                     // First crossing + 360°
+    float endSteps;
+
+    float startAngle;
+    float rawAngle;                     // Last encoder reading
+    float unwrappedAngle;
+    long lastSteps;
+    bool complete;
+
+    bool crossing(float target, float previousAngle, long previousSteps,
+                  long steps, float& stepsAtTarget) const;
+};
@@ -0,0 +1,284 @@
+#include "StepGenerator.h"
+#include "../core/Clock.h"
+#include "../config.h"
+
+StepGenerator::StepGenerator(MotorDriver* driver)
+    : driver(driver)
+    , timer(nullptr)
+    , running(false)
+    , stepIndex(0)
+    , nextStepMicros(0)
+    , lastGap(0)
+    , queueHead(0)
+    , queueTail(0)
+    , stepsEmitted(0)
+    , timerActive(false)
+    , startPosition(0)
+    , coarseTravel(false)
+    , fineApproachSteps(0)
+    , coarseUntil(0)
+    , coarseActive(false)
+    , pendingTarget(false)
+    , pendingPosition(0)
+    , jerk(PLANNER_JERK)
+{
+    profile.direction = 1;
+    profile.totalSteps = 0;
+    profile.rampSteps = 0;
+}
+
+StepGenerator::~StepGenerator() {
+    if (timer) {
+        timer->cancel();
+    }
+}
+
+bool StepGenerator::setTimer(StepTimer* stepTimer) {
+    if (running) {
+        return false;
+    }
+    if (timer) {
+        timer->cancel();
+    }
+    timer = nullptr;
+    if (stepTimer && !stepTimer->begin(&StepGenerator::onTimer, this)) {
+        return false;
+    }
+    timer = stepTimer;
+    return true;
+}
+
+void StepGenerator::move(long steps) {
+    pendingTarget = false;
+    coarseTravel = false;
+    start(steps);
+}
+
+void StepGenerator::moveCoarse(long steps, uint32_t approachSteps) {
+    pendingTarget = false;
+    coarseTravel = true;
+    fineApproachSteps = approachSteps;
+    start(steps);
+}
+
+void StepGenerator::moveTo(long position) {
+    if (!running) {
+        pendingTarget = false;
+        start(position - driver->getCurrentPosition());
+        return;
+    }
+
+    long wanted = position - startPosition;
+
+    // Same direction and not behind the motor: adjust the current profile
+    if ((wanted > 0) == (profile.direction > 0) && wanted * profile.direction >= (long)stepIndex) {
+        uint32_t wantedSteps = (uint32_t)(wanted * profile.direction);
+        planner.retarget(profile, stepIndex, wantedSteps);
+        updateCoarseBoundary();
+
+        // Too late to stop there: come back once stopped
+        pendingTarget = (profile.totalSteps != wantedSteps);
+        pendingPosition = position;
+        return;
+    }
+
+    // Reversal: stop first, continue from wherever the stop ends
+    planner.retarget(profile, stepIndex, stepIndex);
+    updateCoarseBoundary();
+    pendingTarget = true;
+    pendingPosition = position;
+}
+
+void StepGenerator::start(long steps) {
+    running = false;
+    if (steps == 0 || !driver) {
+        return;
+    }
+
+    configurePlanner();
+    profile = planner.plan(steps);
+    startPosition = driver->getCurrentPosition();
+    stepIndex = 0;
+    lastGap = 0;
+    running = true;
+
+    coarseActive = coarseTravel && profile.totalSteps > fineApproachSteps;
+    updateCoarseBoundary();
+
+    if (timer) {
+        queueHead = 0;
+        queueTail = 0;
+        stepsEmitted = 0;
+        timerActive = false;
+        runTimed();  // Queue the first gaps and start the timer
+    } else {
+        nextStepMicros = Clock::system().micros();  // First step is due now
+    }
+}
+
+void StepGenerator::updateCoarseBoundary() {
+    // Only ever moves the boundary; once fine, a move stays fine
+    if (!coarseActive) {
+        return;
+    }
+    coarseUntil = (profile.totalSteps > fineApproachSteps) ? profile.totalSteps - fineApproachSteps : 0;
+}
+
+void IRAM_ATTR StepGenerator::emitStep(uint32_t index) {
+    // The driver switches to fine with the first fine step
+    bool coarse = coarseActive;
+    if (coarse && index >= coarseUntil) {
+        coarseActive = false;
+        coarse = false;
+    }
+    driver->timerStep(profile.direction, coarse);
+}
+
+void StepGenerator::endCoarse() {
+    coarseActive = false;
+    driver->setCoarseStepping(false);
+}
+
+void StepGenerator::configurePlanner() {
+    if (!driver) {
+        return;
+    }
+    float microsteps = driver->getMicrosteps();
+    planner.configure(driver->getMaxSpeed() * microsteps,
+                      driver->getAcceleration() * microsteps,
+                      jerk * microsteps);
+}
+
+bool StepGenerator::run() {
+    if (!running) {
+        return false;
+    }
+    return timer ? runTimed() : runPolled();
+}
+
+bool StepGenerator::runPolled() {
+    unsigned long now = Clock::system().micros();
+    if ((long)(now - nextStepMicros) < 0) {
+        return true;
+    }
+
+    emitStep(stepIndex);
+    stepIndex++;
+
+    if (stepIndex >= profile.totalSteps) {
+        finishProfile();
+        return running;
+    }
+
+    lastGap = planner.gapAfter(profile, stepIndex - 1);
+
+    // A late loop may catch up by one gap, never burst further
+    if ((unsigned long)(now - nextStepMicros) > lastGap) {
+        nextStepMicros = now;
+    }
+    nextStepMicros += lastGap;
+    return true;
+}
+
+bool StepGenerator::runTimed() {
+    timer->poll();
+    fillQueue();
+
+    if (!timerActive) {
+        if (stepsEmitted >= profile.totalSteps) {
+            finishProfile();
+            return running;
+        }
+
+        // Idle with steps left (start, or the queue ran dry): restart
+        if (queueHead != queueTail) {
+            uint32_t gap = gapQueue[queueTail];
+            queueTail = (queueTail + 1) & (QUEUE_SIZE - 1);
+            timerActive = true;
+            timer->schedule(gap);
+        }
+    }
+    return true;
+}
+
+void StepGenerator::fillQueue() {
+    while (stepIndex < profile.totalSteps) {
+        uint8_t next = (queueHead + 1) & (QUEUE_SIZE - 1);
+        if (next == queueTail) {
+            break;  // Full
+        }
+        gapQueue[queueHead] = (stepIndex == 0) ? 0 : planner.gapAfter(profile, stepIndex - 1);
+        queueHead = next;
+        stepIndex++;
+    }
+}
+
+void IRAM_ATTR StepGenerator::onTimer(void* context) {
+    StepGenerator* self = static_cast<StepGenerator*>(context);
+
+    self->emitStep(self->stepsEmitted);
+    self->stepsEmitted = self->stepsEmitted + 1;
+
+    uint8_t tail = self->queueTail;
+    if (tail == self->queueHead) {
+        self->timerActive = false;  // Done, or the loop fell behind
+        return;
+    }
+
+    uint32_t gap = self->gapQueue[tail];
+    self->queueTail = (tail + 1) & (QUEUE_SIZE - 1);
+    self->lastGap = gap;
+    self->timer->rearm(gap);
+}
+
+void StepGenerator::finishProfile() {
+    running = false;
+    lastGap = 0;
+    if (coarseActive) {
+        endCoarse();
+    }
+    if (pendingTarget) {
+        pendingTarget = false;
+        start(pendingPosition - driver->getCurrentPosition());
+    }
+}
+
+void StepGenerator::stop() {
+    pendingTarget = false;
+    if (running) {
+        planner.retarget(profile, stepIndex, stepIndex);
+        updateCoarseBoundary();
+    }
+}
+
+void StepGenerator::abort() {
+    if (timer) {
+        timer->cancel();
+        timerActive = false;
+        queueHead = 0;
+        queueTail = 0;
+    }
+    running = false;
+    pendingTarget = false;
+    lastGap = 0;
+    if (coarseActive) {
+        endCoarse();
+    }
+}
+
+float StepGenerator::getCurrentSpeed() const {
+    if (!running || lastGap == 0) {
+        return 0.0f;
+    }
+    return profile.direction * 1000000.0f / lastGap;
+}
+
+long StepGenerator::getTargetPosition() const {
+    if (pendingTarget) {
+        return pendingPosition;
+    }
+    if (!running) {
+        return driver ? driver->getCurrentPosition() : 0;
+    }
+    return startPosition + (long)profile.totalSteps * profile.direction;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "TrajectoryPlanner.h"
+#include "StepTimer.h"
+#include "../drivers/MotorDriver.h"
+
+/**
+ * Emits the steps of a planned profile through MotorDriver::timerStep()
+ *
+ * Without a timer, run() is polled from the main loop, compares the clock
+ * with the next step deadline and issues at most one step per call.
+ *
+ * With a StepTimer, steps are emitted from the timer callback. run() then
+ * only keeps a small queue of upcoming gaps filled from the profile (single
+ * producer / single consumer, no locking), so step timing no longer depends
+ * on loop jitter and rates above the 1 kHz loop are possible. The callback
+ * path (onTimer, emitStep, timerStep, StepTimer::rearm) is IRAM_ATTR with no
+ * virtual calls, so stepping continues through flash writes on the ESP32.
+ *
+ * Step positions are driver positions (getCurrentPosition()), so moves mix
+ * freely with the driver's own AccelStepper commands. Profiles are planned
+ * in driver steps: one timerStep() per microstep.
+ */
+class StepGenerator {
+public:
+    explicit StepGenerator(MotorDriver* driver);
+    ~StepGenerator();
+
+    /**
+     * Emit steps from a timer callback (nullptr = poll from run())
+     * Must not be called while a move is running.
+     * @return true if the timer was attached
+     */
+    bool setTimer(StepTimer* stepTimer);
+    bool usesTimer() const { return timer != nullptr; }
+
+    /**
+     * Start a relative move using the driver's max speed and acceleration
+     */
+    void move(long steps);
+
+    /**
+     * Relative move at the driver's coarse resolution (ULN2003 full steps),
+     * switched to the fine resolution for the last approachSteps steps.
+     * The switch happens where the steps are emitted, timer or loop.
+     */
+    void moveCoarse(long steps, uint32_t approachSteps);
+
+    /**
+     * Move to an absolute driver position
+     * While running in the same direction the profile is stretched or
+     * shortened in place; a target behind the motor is queued and started
+     * after the current profile stops.
+     */
+    void moveTo(long position);
+
+    /**
+     * Issue the next step if it is due (polled), or refill the step queue
+     * (timer)
+     * @return true while a move is in progress
+     */
+    bool run();
+
+    /**
+     * Decelerate to a stop as soon as the profile allows
+     */
+    void stop();
+
+    /**
+     * Drop the profile immediately (no deceleration)
+     */
+    void abort();
+
+    bool isRunning() const { return running; }
+
+    /**
+     * Current speed in steps/s (signed)
+     */
+    float getCurrentSpeed() const;
+
+    /**
+     * Final driver position of the move (including a queued target)
+     */
+    long getTargetPosition() const;
+
+    /**
+     * Jerk limit for subsequent moves (full steps/s³), 0 = trapezoidal
+     */
+    void setJerk(float jerkLimit) { jerk = jerkLimit; }
+    float getJerk() const { return jerk; }
+
+    /**
+     * Load the driver's speed, acceleration and the jerk limit into the
+     * planner, converted from full steps to driver steps
+     */
+    void configurePlanner();
+
+    TrajectoryPlanner& getPlanner() { return planner; }
+    const MotionProfile& getProfile() const { return profile; }
+
+    static constexpr uint8_t QUEUE_SIZE = 16;   // Power of two
+
+private:
+    MotorDriver* driver;
+    TrajectoryPlanner planner;
+    MotionProfile profile;
+    StepTimer* timer;
+
+    bool running;
+    uint32_t stepIndex;             // Steps handed out (polled: emitted, timer: queued)
+    unsigned long nextStepMicros;
+    volatile uint32_t lastGap;
+
+    // Timer mode: delay before each queued step, consumed by the callback
+    volatile uint32_t gapQueue[QUEUE_SIZE];
+    volatile uint8_t queueHead;     // Written by run() only
+    volatile uint8_t queueTail;     // Written by the callback (by run() only while the timer is idle)
+    volatile uint32_t stepsEmitted;
+    volatile bool timerActive;
+    long startPosition;
+    bool coarseTravel;              // Set by moveCoarse(), kept across retargets
+    uint32_t fineApproachSteps;
+    volatile uint32_t coarseUntil;  // Step index where fine stepping starts
+    volatile bool coarseActive;
+    bool pendingTarget;             // Target behind the motor, start after stopping
+    long pendingPosition;
+    float jerk;
+
+    void start(long steps);
+    void updateCoarseBoundary();
+    void emitStep(uint32_t index);
+    void endCoarse();
+    bool runPolled();
+    bool runTimed();
+    void fillQueue();
+    void finishProfile();
+
+    static void onTimer(void* context);
+};
@@ -0,0 +1,182 @@
+#include "StepScheduler.h"
+#include "../core/Clock.h"
+
+namespace {
+
+#if defined(ESP32) && !defined(ARDUINO_HOST)
+// Keeps the timer interrupt out while the main loop re-arms a channel
+portMUX_TYPE schedulerMux = portMUX_INITIALIZER_UNLOCKED;
+inline __attribute__((always_inline)) void lockScheduler() { portENTER_CRITICAL_SAFE(&schedulerMux); }
+inline __attribute__((always_inline)) void unlockScheduler() { portEXIT_CRITICAL_SAFE(&schedulerMux); }
+#else
+inline void lockScheduler() {}
+inline void unlockScheduler() {}
+#endif
+
+} // namespace
+
+StepScheduler::StepScheduler()
+    : channels{}
+    , channelCount(0)
+    , dispatching(nullptr)
+    , fireCount(0)
+    , dispatchCount(0)
+{
+}
+
+StepScheduler::~StepScheduler() {
+    if (hardwareTimer) {
+        hardwareTimer->cancel();
+    }
+    for (uint8_t i = 0; i < channelCount; i++) {
+        channels[i]->scheduler = nullptr;
+    }
+}
+
+bool StepScheduler::begin(std::unique_ptr<StepTimer> timer) {
+    if (hardwareTimer || !timer) {
+        return false;
+    }
+    if (!timer->begin(&StepScheduler::onTimer, this)) {
+        return false;
+    }
+    hardwareTimer = std::move(timer);
+    return true;
+}
+
+std::unique_ptr<StepTimer> StepScheduler::createChannel() {
+    if (!hardwareTimer || channelCount >= MAX_CHANNELS) {
+        return nullptr;
+    }
+
+    Channel* channel = new Channel(this);
+    lockScheduler();
+    channels[channelCount++] = channel;
+    unlockScheduler();
+    return std::unique_ptr<StepTimer>(channel);
+}
+
+void StepScheduler::removeChannel(Channel* channel) {
+    lockScheduler();
+    for (uint8_t i = 0; i < channelCount; i++) {
+        if (channels[i] == channel) {
+            channels[i] = channels[--channelCount];
+            break;
+        }
+    }
+    unlockScheduler();
+}
+
+StepScheduler::Channel* IRAM_ATTR StepScheduler::earliestChannel() const {
+    Channel* next = nullptr;
+    for (uint8_t i = 0; i < channelCount; i++) {
+        Channel* channel = channels[i];
+        if (channel->armed && (!next || (long)(channel->deadline - next->deadline) < 0)) {
+            next = channel;
+        }
+    }
+    return next;
+}
+
+void IRAM_ATTR StepScheduler::onTimer(void* context) {
+    StepScheduler* self = static_cast<StepScheduler*>(context);
+
+    lockScheduler();
+    self->fireCount = self->fireCount + 1;
+    self->dispatchDue();
+    self->armNext();
+    unlockScheduler();
+}
+
+void IRAM_ATTR StepScheduler::dispatchDue() {
+    // Bounded, so a channel that keeps re-arming in the past cannot hold
+    // the interrupt; anything still due fires on the next interrupt
+    for (uint8_t round = 0; round < MAX_CHANNELS * 2; round++) {
+        Channel* next = earliestChannel();
+        if (!next || (long)(next->deadline - Clock::interruptMicros()) > 0) {
+            return;
+        }
+
+        next->armed = false;
+        dispatching = next;
+        dispatchCount = dispatchCount + 1;
+        if (next->callback) {
+            next->callback(next->context);
+        }
+        dispatching = nullptr;
+    }
+}
+
+void IRAM_ATTR StepScheduler::armNext() {
+    // With nothing armed the one-shot timer that just fired stays idle
+    Channel* next = earliestChannel();
+    if (!next) {
+        return;
+    }
+
+    long delay = (long)(next->deadline - Clock::interruptMicros());
+    hardwareTimer->rearm(delay > 0 ? (uint32_t)delay : 1);
+}
+
+StepScheduler::Channel::Channel(StepScheduler* scheduler)
+    : StepTimer(&Channel::rearmChannel)
+    , scheduler(scheduler)
+    , callback(nullptr)
+    , context(nullptr)
+    , deadline(0)
+    , armed(false)
+{
+}
+
+StepScheduler::Channel::~Channel() {
+    if (scheduler) {
+        scheduler->removeChannel(this);
+    }
+}
+
+bool StepScheduler::Channel::begin(Callback cb, void* ctx) {
+    callback = cb;
+    context = ctx;
+    return scheduler && scheduler->isRunning();
+}
+
+void IRAM_ATTR StepScheduler::Channel::rearmChannel(StepTimer* timer, uint32_t delayMicros) {
+    static_cast<Channel*>(timer)->Channel::schedule(delayMicros);
+}
+
+void IRAM_ATTR StepScheduler::Channel::schedule(uint32_t delayMicros) {
+    if (!scheduler) return;
+    if (delayMicros == 0) delayMicros = 1;
+    unsigned long now = Clock::interruptMicros();
+
+    if (scheduler->dispatching == this) {
+        // Re-armed from its own step: keep the planned spacing. A late
+        // dispatch may catch up by one gap, never burst further.
+        unsigned long base = deadline;
+        if ((unsigned long)(now - base) > delayMicros) {
+            base = now;
+        }
+        deadline = base + delayMicros;
+        armed = true;
+        return;  // onTimer() re-arms the hardware timer
+    }
+
+    lockScheduler();
+    deadline = now + delayMicros;
+    armed = true;
+    if (!scheduler->dispatching) {
+        scheduler->armNext();
+    }
+    unlockScheduler();
+}
+
+void StepScheduler::Channel::cancel() {
+    // The hardware timer stays armed; a fire with nothing due is harmless
+    armed = false;
+}
+
+void StepScheduler::Channel::poll() {
+    if (scheduler && scheduler->hardwareTimer) {
+        scheduler->hardwareTimer->poll();
+    }
+}
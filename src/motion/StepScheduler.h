@@ -0,0 +1,84 @@
+#pragma once
+
+#include "StepTimer.h"
+#include <stdint.h>
+#include <memory>
+
+/**
+ * Shares one hardware StepTimer between several StepGenerators
+ *
+ * Each generator gets a channel, a StepTimer of its own. The scheduler
+ * keeps the next step deadline of every channel and arms the hardware timer
+ * for the earliest one; when it fires, every due step is issued in deadline
+ * order and the timer is re-armed for the next. The step timelines of all
+ * motors are merged into one time-ordered stream, so several wheels move
+ * concurrently from a single timer (the ESP32-C3 has only two).
+ *
+ * A deadline re-armed from a channel callback counts from that step's own
+ * deadline, not from the (slightly later) dispatch, so motors sharing the
+ * timer keep their planned step spacing.
+ */
+class StepScheduler {
+public:
+    static constexpr uint8_t MAX_CHANNELS = 4;
+
+    StepScheduler();
+    ~StepScheduler();
+
+    /**
+     * Take the hardware timer
+     * @return true if the timer is available
+     */
+    bool begin(std::unique_ptr<StepTimer> timer);
+    bool isRunning() const { return hardwareTimer != nullptr; }
+
+    /**
+     * Timer for one StepGenerator; destroy it before the scheduler
+     * @return nullptr without a hardware timer or with all channels taken
+     */
+    std::unique_ptr<StepTimer> createChannel();
+
+    uint8_t getChannelCount() const { return channelCount; }
+
+    /**
+     * Hardware timer interrupts so far, and steps dispatched from them
+     */
+    uint32_t getFireCount() const { return fireCount; }
+    uint32_t getDispatchCount() const { return dispatchCount; }
+
+private:
+    class Channel : public StepTimer {
+    public:
+        explicit Channel(StepScheduler* scheduler);
+        ~Channel() override;
+
+        bool begin(Callback callback, void* context) override;
+        void schedule(uint32_t delayMicros) override;
+        void cancel() override;
+        void poll() override;
+
+    private:
+        friend class StepScheduler;
+        StepScheduler* scheduler;
+        Callback callback;
+        void* context;
+        volatile unsigned long deadline;
+        volatile bool armed;
+
+        static void rearmChannel(StepTimer* timer, uint32_t delayMicros);
+    };
+
+    std::unique_ptr<StepTimer> hardwareTimer;
+    Channel* channels[MAX_CHANNELS];
+    uint8_t channelCount;
+    Channel* volatile dispatching;  // Channel whose callback is running
+    volatile uint32_t fireCount;
+    volatile uint32_t dispatchCount;
+
+    void removeChannel(Channel* channel);
+    Channel* earliestChannel() const;
+    void dispatchDue();
+    void armNext();
+
+    static void onTimer(void* context);
+};
@@ -0,0 +1,94 @@
+#include "StepTimer.h"
+
+#if defined(ESP32) && !defined(ARDUINO_HOST)
+
+#include <driver/timer.h>
+
+Esp32StepTimer* Esp32StepTimer::instances[Esp32StepTimer::MAX_TIMERS] = {nullptr};
+
+Esp32StepTimer::Esp32StepTimer(uint8_t timerNumber)
+    : StepTimer(&Esp32StepTimer::rearmTimer)
+    , timerNumber(timerNumber)
+    , timer(nullptr)
+    , callback(nullptr)
+    , context(nullptr)
+{
+}
+
+Esp32StepTimer::~Esp32StepTimer() {
+    if (timer) {
+        timerAlarmDisable(timer);
+        timerDetachInterrupt(timer);
+        timerEnd(timer);
+    }
+    if (timerNumber < MAX_TIMERS && instances[timerNumber] == this) {
+        instances[timerNumber] = nullptr;
+    }
+}
+
+bool Esp32StepTimer::begin(Callback cb, void* ctx) {
+    if (timerNumber >= MAX_TIMERS || instances[timerNumber]) {
+        return false;
+    }
+
+    // 80 MHz APB clock / 80 = 1 tick per microsecond
+    timer = timerBegin(timerNumber, 80, true);
+    if (!timer) {
+        return false;
+    }
+
+    callback = cb;
+    context = ctx;
+    instances[timerNumber] = this;
+
+    static void (*const handlers[MAX_TIMERS])() = {onTimer0, onTimer1, onTimer2, onTimer3};
+    timerAttachInterrupt(timer, handlers[timerNumber], true);
+    return true;
+}
+
+void IRAM_ATTR Esp32StepTimer::schedule(uint32_t delayMicros) {
+    if (!timer) return;
+    if (delayMicros < 2) delayMicros = 2;  // Alarm must stay ahead of the counter read
+
+    // The Arduino timerWrite()/timerAlarmWrite() live in flash: use the IDF's
+    // IRAM calls and set the alarm relative to the free-running counter
+    timer_group_t group = (timer_group_t)(timerNumber / SOC_TIMER_GROUP_TIMERS_PER_GROUP);
+    timer_idx_t index = (timer_idx_t)(timerNumber % SOC_TIMER_GROUP_TIMERS_PER_GROUP);
+    uint64_t now = timer_group_get_counter_value_in_isr(group, index);
+    timer_group_set_alarm_value_in_isr(group, index, now + delayMicros);
+    timer_group_enable_alarm_in_isr(group, index);
+}
+
+void IRAM_ATTR Esp32StepTimer::rearmTimer(StepTimer* timer, uint32_t delayMicros) {
+    static_cast<Esp32StepTimer*>(timer)->Esp32StepTimer::schedule(delayMicros);
+}
+
+void Esp32StepTimer::cancel() {
+    if (timer) {
+        timerAlarmDisable(timer);
+    }
+}
+
+void IRAM_ATTR Esp32StepTimer::handleInterrupt() {
+    if (callback) {
+        callback(context);
+    }
+}
+
+void IRAM_ATTR Esp32StepTimer::onTimer0() { if (instances[0]) instances[0]->handleInterrupt(); }
+void IRAM_ATTR Esp32StepTimer::onTimer1() { if (instances[1]) instances[1]->handleInterrupt(); }
+void IRAM_ATTR Esp32StepTimer::onTimer2() { if (instances[2]) instances[2]->handleInterrupt(); }
+void IRAM_ATTR Esp32StepTimer::onTimer3() { if (instances[3]) instances[3]->handleInterrupt(); }
+
+std::unique_ptr<StepTimer> StepTimer::createPlatformTimer(uint8_t timerNumber) {
+    return std::unique_ptr<StepTimer>(new Esp32StepTimer(timerNumber));
+}
+
+#else
+
+std::unique_ptr<StepTimer> StepTimer::createPlatformTimer(uint8_t timerNumber) {
+    (void)timerNumber;
+    return nullptr;
+}
+
+#endif
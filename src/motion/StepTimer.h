@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <memory>
+
+/**
+ * One-shot microsecond timer that drives StepGenerator from interrupt context
+ *
+ * rearm() is called from the callback to arm the next step, so
+ * implementations must allow re-arming inside the callback.
+ */
+class StepTimer {
+public:
+    typedef void (*Callback)(void* context);
+
+    StepTimer() : rearmFunction(&StepTimer::rearmThroughTimer) {}
+    virtual ~StepTimer() = default;
+
+    /**
+     * Attach the callback
+     * @return true if the timer hardware is available
+     */
+    virtual bool begin(Callback callback, void* context) = 0;
+
+    /**
+     * Fire the callback once, delayMicros from now
+     */
+    virtual void schedule(uint32_t delayMicros) = 0;
+
+    /**
+     * Disarm a pending callback
+     */
+    virtual void cancel() = 0;
+
+    /**
+     * Called from the main loop; timers without their own interrupt source
+     * fire due callbacks here
+     */
+    virtual void poll() {}
+
+    /**
+     * Hardware timer for this platform, or null (steps are then polled
+     * from the main loop)
+     * @param timerNumber Hardware timer index
+     */
+    static std::unique_ptr<StepTimer> createPlatformTimer(uint8_t timerNumber = 0);
+
+    /**
+     * schedule() for the callback. Not virtual: the vtable is in flash on
+     * the ESP32, so interrupt-driven timers pass an IRAM_ATTR function.
+     */
+    inline __attribute__((always_inline)) void rearm(uint32_t delayMicros) {
+        rearmFunction(this, delayMicros);
+    }
+
+protected:
+    typedef void (*RearmFunction)(StepTimer* timer, uint32_t delayMicros);
+
+    explicit StepTimer(RearmFunction rearm) : rearmFunction(rearm) {}
+
+private:
+    RearmFunction rearmFunction;
+
+    static void rearmThroughTimer(StepTimer* timer, uint32_t delayMicros) {
+        timer->schedule(delayMicros);
+    }
+};
+
+#if defined(ESP32) && !defined(ARDUINO_HOST)
+
+/**
+ * ESP32 general-purpose timer at 1 MHz (Arduino-ESP32 2.x timer API, IDF
+ * *_in_isr calls to re-arm). The core registers the interrupt without
+ * ESP_INTR_FLAG_IRAM, so it is held off during flash writes; the IRAM
+ * placement keeps flash cache misses off the step path otherwise.
+ */
+class Esp32StepTimer : public StepTimer {
+public:
+    static constexpr uint8_t MAX_TIMERS = 4;
+
+    explicit Esp32StepTimer(uint8_t timerNumber);
+    ~Esp32StepTimer() override;
+
+    bool begin(Callback callback, void* context) override;
+    void schedule(uint32_t delayMicros) override;
+    void cancel() override;
+
+private:
+    uint8_t timerNumber;
+    hw_timer_t* timer;
+    Callback callback;
+    void* context;
+
+    static Esp32StepTimer* instances[MAX_TIMERS];
+    static void IRAM_ATTR onTimer0();
+    static void IRAM_ATTR onTimer1();
+    static void IRAM_ATTR onTimer2();
+    static void IRAM_ATTR onTimer3();
+    void IRAM_ATTR handleInterrupt();
+    static void IRAM_ATTR rearmTimer(StepTimer* timer, uint32_t delayMicros);
+};
+
+#endif
@@ -0,0 +1,159 @@
+#include "TrajectoryPlanner.h"
+#include <math.h>
+
+TrajectoryPlanner::TrajectoryPlanner()
+    : rampEntries(0)
+    , rampStride(1)
+    , rampLength(0)
+    , cruiseGap(0)
+    , maxSpeed(0.0f)
+    , acceleration(0.0f)
+    , jerk(0.0f)
+{
+}
+
+bool TrajectoryPlanner::configure(float newMaxSpeed, float newAcceleration, float newJerk) {
+    if (newMaxSpeed <= 0.0f || newAcceleration <= 0.0f || newJerk < 0.0f) {
+        return false;
+    }
+
+    if (rampLength > 0 && newMaxSpeed == maxSpeed &&
+        newAcceleration == acceleration && newJerk == jerk) {
+        return true;  // Table is current
+    }
+
+    maxSpeed = newMaxSpeed;
+    acceleration = newAcceleration;
+    jerk = newJerk;
+    cruiseGap = (uint32_t)(1000000.0f / maxSpeed);
+
+    if (jerk > 0.0f) {
+        buildSCurveRamp();
+    } else {
+        buildTrapezoidalRamp();
+    }
+
+    // Table too short to reach max speed: cruise at the last ramp speed
+    if (rampEntries == MAX_RAMP_STEPS) {
+        cruiseGap = rampTable[rampEntries - 1];
+    }
+    rampLength = (uint32_t)rampEntries * rampStride;
+    return true;
+}
+
+void TrajectoryPlanner::setStride(float estimatedRampSteps) {
+    // Coarsen only when the whole ramp does not fit (with some margin)
+    float stride = ceilf(estimatedRampSteps * 1.25f / MAX_RAMP_STEPS);
+    rampStride = (stride > 1.0f) ? (uint16_t)fminf(stride, 65535.0f) : 1;
+}
+
+void TrajectoryPlanner::buildTrapezoidalRamp() {
+    // Constant acceleration from standstill: step k happens at sqrt(2k/a)
+    setStride(maxSpeed * maxSpeed / (2.0f * acceleration));
+    rampEntries = 0;
+    double previous = 0.0;
+    for (uint32_t k = rampStride; rampEntries < MAX_RAMP_STEPS; k += rampStride) {
+        double t = sqrt(2.0 * k / acceleration) * 1000000.0;
+        uint32_t gap = (uint32_t)((t - previous) / rampStride + 0.5);
+        if (gap <= cruiseGap) {
+            break;
+        }
+        rampTable[rampEntries++] = gap;
+        previous = t;
+    }
+}
+
+void TrajectoryPlanner::buildSCurveRamp() {
+    // Integrate the jerk-limited velocity curve and record when the position
+    // crosses each table entry (every rampStride steps). Acceleration peaks
+    // at amax, or lower when max speed is reached before amax (vmax < amax²/j).
+    const float dt = 0.00005f;  // 50 µs
+    float peakAccel = acceleration;
+    if (maxSpeed < acceleration * acceleration / jerk) {
+        peakAccel = sqrtf(maxSpeed * jerk);
+    }
+    setStride(maxSpeed * maxSpeed / (2.0f * peakAccel) + maxSpeed * peakAccel / (2.0f * jerk));
+
+    rampEntries = 0;
+    float t = 0.0f, v = 0.0f, a = 0.0f, x = 0.0f;
+    float previousStepTime = 0.0f;
+    uint32_t nextStep = rampStride;
+
+    while (rampEntries < MAX_RAMP_STEPS && t < 60.0f) {
+        // Start easing out when the velocity still to gain equals what the
+        // jerk-down phase adds on its own
+        if (maxSpeed - v <= a * a / (2.0f * jerk)) {
+            a -= jerk * dt;
+            if (a <= 0.0f) {
+                break;
+            }
+        } else if (a < peakAccel) {
+            a += jerk * dt;
+            if (a > peakAccel) a = peakAccel;
+        }
+
+        float previousX = x;
+        v += a * dt;
+        x += v * dt;
+        t += dt;
+
+        while (x >= (float)nextStep && rampEntries < MAX_RAMP_STEPS) {
+            // Interpolate the crossing time inside this integration step
+            float crossing = t - dt * (x - (float)nextStep) / (x - previousX);
+            uint32_t gap = (uint32_t)((crossing - previousStepTime) * 1000000.0f / rampStride + 0.5f);
+            if (gap <= cruiseGap) {
+                return;
+            }
+            rampTable[rampEntries++] = gap;
+            previousStepTime = crossing;
+            nextStep += rampStride;
+        }
+    }
+}
+
+MotionProfile TrajectoryPlanner::plan(long steps) const {
+    MotionProfile profile;
+    profile.direction = (steps < 0) ? -1 : 1;
+    profile.totalSteps = (uint32_t)((steps < 0) ? -steps : steps);
+
+    uint32_t halfGaps = (profile.totalSteps > 0) ? (profile.totalSteps - 1) / 2 : 0;
+    profile.rampSteps = (halfGaps < rampLength) ? halfGaps : rampLength;
+    return profile;
+}
+
+void TrajectoryPlanner::retarget(MotionProfile& profile, uint32_t stepsDone, uint32_t newTotal) const {
+    if (stepsDone == 0) {
+        int8_t direction = profile.direction;
+        profile = plan((long)newTotal);
+        profile.direction = direction;
+        return;
+    }
+
+    uint32_t gap = stepsDone - 1;  // Gap in use right now
+    uint32_t ramp = profile.rampSteps;
+
+    if (gap < ramp) {
+        // Accelerating: the ramp may grow or shrink, but not below the
+        // current speed level
+        uint32_t halfGaps = (newTotal > 0) ? (newTotal - 1) / 2 : 0;
+        uint32_t newRamp = (halfGaps < rampLength) ? halfGaps : rampLength;
+        if (newRamp < gap) {
+            newRamp = gap;
+        }
+        profile.rampSteps = newRamp;
+        profile.totalSteps = (newTotal > 2 * newRamp + 1) ? newTotal : 2 * newRamp + 1;
+    } else if (gap + 1 + ramp < profile.totalSteps) {
+        // Cruising: deceleration can start at the earliest now
+        uint32_t earliest = gap + 1 + ramp;
+        profile.totalSteps = (newTotal > earliest) ? newTotal : earliest;
+    }
+    // Decelerating: keep the profile, the caller corrects after the stop
+}
+
+uint32_t TrajectoryPlanner::getDurationMicros(const MotionProfile& profile) const {
+    uint32_t total = 0;
+    for (uint32_t i = 0; i + 1 < profile.totalSteps; i++) {
+        total += gapAfter(profile, i);
+    }
+    return total;
+}
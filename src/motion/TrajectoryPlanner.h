@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Step timing of one planned move
+ * Steps are numbered 0..totalSteps-1; gap i is the time between step i and
+ * step i+1. The first rampSteps gaps accelerate, the last rampSteps gaps
+ * mirror them, everything in between cruises.
+ */
+struct MotionProfile {
+    int8_t direction;       // +1 or -1
+    uint32_t totalSteps;
+    uint32_t rampSteps;     // Gaps in each of the acceleration/deceleration ramps
+};
+
+/**
+ * Trapezoidal / S-curve trajectory planner
+ *
+ * The acceleration ramp from standstill to max speed is computed once per
+ * speed/acceleration/jerk setting as a table of step gaps in microseconds.
+ * Planning a move is then O(1) (ramp length vs. half the distance) and
+ * consuming it costs a table lookup per step, with no floating point.
+ *
+ * Ramps longer than the table (high microstep rates) store one gap per
+ * group of rampStride steps, the mean gap of that group.
+ *
+ * Short moves use a truncated ramp mirrored at mid-distance (triangular
+ * profile). With jerk limiting this leaves an acceleration reversal at the
+ * midpoint of moves shorter than two full ramps.
+ */
+class TrajectoryPlanner {
+public:
+    static constexpr uint16_t MAX_RAMP_STEPS = 1024;  // Ramp table entries (4 bytes each)
+
+    TrajectoryPlanner();
+
+    /**
+     * Rebuild the ramp table if any parameter changed
+     * @param maxSpeed Cruise speed (steps/s)
+     * @param acceleration Acceleration (steps/s²)
+     * @param jerk Jerk limit (steps/s³), 0 = trapezoidal
+     * @return true if the parameters are usable
+     */
+    bool configure(float maxSpeed, float acceleration, float jerk = 0.0f);
+
+    /**
+     * Plan a relative move
+     */
+    MotionProfile plan(long steps) const;
+
+    /**
+     * Change the length of a profile in progress (same direction)
+     * Lengthening is honoured until deceleration has started; if the new
+     * length is too short to stop in, deceleration starts immediately and
+     * the move ends past it.
+     * @param stepsDone Steps already emitted
+     * @param newTotal Requested total steps from the profile start
+     */
+    void retarget(MotionProfile& profile, uint32_t stepsDone, uint32_t newTotal) const;
+
+    /**
+     * Gap after step index (microseconds)
+     */
+    uint32_t gapAfter(const MotionProfile& profile, uint32_t index) const {
+        uint32_t ramp = profile.rampSteps;
+        if (index < ramp) {
+            return rampTable[index / rampStride];
+        }
+        if (index + 1 + ramp >= profile.totalSteps) {
+            return rampTable[(profile.totalSteps - 2 - index) / rampStride];
+        }
+        return (ramp < rampLength) ? rampTable[ramp / rampStride] : cruiseGap;
+    }
+
+    /**
+     * Total duration of a profile (microseconds), for statistics
+     */
+    uint32_t getDurationMicros(const MotionProfile& profile) const;
+
+    uint32_t getRampLength() const { return rampLength; }
+    uint16_t getRampStride() const { return rampStride; }
+    uint32_t getCruiseGap() const { return cruiseGap; }
+    bool isJerkLimited() const { return jerk > 0.0f; }
+
+private:
+    uint32_t rampTable[MAX_RAMP_STEPS];
+    uint16_t rampEntries;
+    uint16_t rampStride;    // Steps per table entry
+    uint32_t rampLength;    // Ramp length in steps (rampEntries * rampStride)
+    uint32_t cruiseGap;
+
+    float maxSpeed;
+    float acceleration;
+    float jerk;
+
+    void setStride(float estimatedRampSteps);
+    void buildTrapezoidalRamp();
+    void buildSCurveRamp();
+};
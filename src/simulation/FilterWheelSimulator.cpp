@@ -0,0 +1,280 @@
+#include "FilterWheelSimulator.h"
+#include "../core/Clock.h"
+
+#ifdef ARDUINO_HOST
+
+#include <math.h>
+
+FilterWheelSimulator::FilterWheelSimulator(const SimulatorConfig& config)
+    : config(config)
+{
+    reset();
+}
+
+void FilterWheelSimulator::reset() {
+    rotorPosition = lroundf(config.initialWheelSteps);
+    commandedSteps = lround(rotorPosition) * config.microsteps;
+    rotorVelocity = 0.0;
+    wheelPosition = config.initialWheelSteps;
+    energized = false;
+    stepDirection = 1;
+    loadAverage = 0.0;
+    velocityAverage = 0.0;
+    lastUpdateMicros = 0;
+    timeInitialized = false;
+    rngState = config.seed ? config.seed : 1;
+}
+
+// ============================================
+// MOTOR SIDE
+// ============================================
+
+void FilterWheelSimulator::step(int8_t direction) {
+    advance();
+    if (!energized) {
+        return;  // Coils off: step pulses have no effect
+    }
+    stepDirection = (direction >= 0) ? 1 : -1;
+    commandedSteps += stepDirection;
+}
+
+void FilterWheelSimulator::setEnergized(bool on) {
+    advance();
+    if (on && !energized) {
+        // Coils snap the rotor to the nearest full-step equilibrium
+        commandedSteps = lround(rotorPosition) * config.microsteps;
+    }
+    energized = on;
+}
+
+// ============================================
+// OBSERVATION
+// ============================================
+
+float FilterWheelSimulator::getWheelAngle() {
+    advance();
+    double degrees = fmod(wheelPosition * 360.0 / config.stepsPerRevolution, 360.0);
+    if (degrees < 0) degrees += 360.0;
+    return (float)degrees;
+}
+
+uint16_t FilterWheelSimulator::readEncoderCounts() {
+    float degrees = getWheelAngle() + config.encoderOffsetDegrees;
+    if (config.encoderMirrored) {
+        degrees = 360.0f - degrees;
+    }
+
+    float counts = degrees * 4096.0f / 360.0f;
+    if (config.encoderNoiseCounts > 0) {
+        counts += nextGaussian() * config.encoderNoiseCounts;
+    }
+
+    long quantized = lroundf(counts) % 4096;
+    if (quantized < 0) quantized += 4096;
+    return (uint16_t)quantized;
+}
+
+float FilterWheelSimulator::getRotorVelocity() {
+    advance();
+    return (float)rotorVelocity;
+}
+
+uint16_t FilterWheelSimulator::readStallGuard() {
+    advance();
+    float reading = 510.0f * (1.0f - (float)loadAverage);
+
+    float speed = (float)velocityAverage * stepDirection;
+    if (speed < config.stallGuardMinVelocity) {
+        reading *= (speed > 0.0f) ? speed / config.stallGuardMinVelocity : 0.0f;
+    }
+    if (config.stallGuardNoise > 0) {
+        reading += nextGaussian() * config.stallGuardNoise;
+    }
+
+    if (reading < 0.0f) reading = 0.0f;
+    if (reading > 510.0f) reading = 510.0f;
+    return (uint16_t)lroundf(reading);
+}
+
+long FilterWheelSimulator::getMissedSteps() {
+    advance();
+    // Each pole slip moves the equilibrium by one electrical period (4 full steps)
+    double lag = commandedPosition() - rotorPosition;
+    return lround(lag / 4.0) * 4 * config.microsteps;
+}
+
+bool FilterWheelSimulator::isAtRest() {
+    advance();
+    return isHeld();
+}
+
+// ============================================
+// INTEGRATION
+// ============================================
+
+void FilterWheelSimulator::advance() {
+    advanceTo(Clock::system().micros());
+}
+
+void FilterWheelSimulator::advanceTo(unsigned long nowMicros) {
+    if (!timeInitialized) {
+        lastUpdateMicros = nowMicros;
+        timeInitialized = true;
+        return;
+    }
+
+    const unsigned long stepMicros = (unsigned long)(INTEGRATION_STEP_S * 1e6f);
+    unsigned long elapsed = nowMicros - lastUpdateMicros;
+
+    while (elapsed >= stepMicros) {
+        // Static friction (or the stop) holds a stopped rotor: skip the rest of the interval
+        if (isHeld()) {
+            filterStallGuard((elapsed - elapsed % stepMicros) / 1e6);
+            elapsed = elapsed % stepMicros;
+            break;
+        }
+        integrate(INTEGRATION_STEP_S);
+        elapsed -= stepMicros;
+    }
+
+    lastUpdateMicros = nowMicros - elapsed;
+}
+
+double FilterWheelSimulator::commandedPosition() const {
+    // Microstepping shapes the coil currents, the equilibrium moves in fractions of a step
+    return (double)commandedSteps / config.microsteps;
+}
+
+float FilterWheelSimulator::driveAcceleration() const {
+    float drive = 0.0f;
+
+    if (energized) {
+        double lag = commandedPosition() - rotorPosition;
+        drive += config.holdingAcceleration * (float)sin(lag * M_PI / 2.0);
+    }
+
+    if (config.loadImbalance != 0.0f) {
+        double wheelRadians = wheelPosition * 2.0 * M_PI / config.stepsPerRevolution;
+        drive -= config.loadImbalance * (float)sin(wheelRadians);
+    }
+
+    return drive;
+}
+
+float FilterWheelSimulator::frictionAt() const {
+    if (config.bindingFriction == 0.0f) {
+        return config.coulombFriction;
+    }
+    double into = fmod(wheelPosition - config.bindingSteps, (double)config.stepsPerRevolution);
+    if (into < 0) into += config.stepsPerRevolution;
+    return (into < config.bindingWidthSteps) ? config.coulombFriction + config.bindingFriction
+                                             : config.coulombFriction;
+}
+
+void FilterWheelSimulator::integrate(float dt) {
+    float drive = driveAcceleration();
+    float friction = frictionAt();
+    double velocity = rotorVelocity;
+    double acceleration;
+
+    if (velocity == 0.0) {
+        if (fabsf(drive) <= friction) {
+            return;  // Stiction
+        }
+        acceleration = drive - copysignf(friction, drive);
+    } else {
+        acceleration = drive - config.viscousFriction * velocity
+                     - copysign((double)friction, velocity);
+    }
+
+    double newVelocity = velocity + acceleration * dt;
+
+    // Friction cannot reverse motion on its own: stop at the zero crossing
+    if (velocity != 0.0 && (newVelocity * velocity) < 0.0 && fabsf(drive) <= friction) {
+        newVelocity = 0.0;
+    }
+
+    rotorVelocity = newVelocity;
+    rotorPosition += newVelocity * dt;
+    applyBacklash();
+    applyHardStop();
+    filterStallGuard(dt);
+}
+
+void FilterWheelSimulator::filterStallGuard(double dt) {
+    double lag = commandedPosition() - rotorPosition;
+    double load = energized ? fabs(sin(lag * M_PI / 2.0)) : 0.0;
+    double keep = exp(-dt / config.stallGuardFilterTime);
+    loadAverage = load + (loadAverage - load) * keep;
+    velocityAverage = rotorVelocity + (velocityAverage - rotorVelocity) * keep;
+}
+
+bool FilterWheelSimulator::isHeld() const {
+    if (rotorVelocity != 0.0) {
+        return false;
+    }
+    float drive = driveAcceleration();
+    if (fabsf(drive) <= frictionAt()) {
+        return true;
+    }
+    if (!config.hardStop) {
+        return false;
+    }
+
+    // Pushed against the stop with the gear play taken up
+    double halfPlay = config.backlashSteps / 2.0;
+    if (drive > 0) {
+        return rotorPosition >= config.hardStopSteps + halfPlay;
+    }
+    return rotorPosition <= config.hardStopSteps - config.stepsPerRevolution - halfPlay;
+}
+
+void FilterWheelSimulator::applyBacklash() {
+    // Wheel is dragged only once the motor has crossed the gear play
+    double halfPlay = config.backlashSteps / 2.0;
+    double gap = rotorPosition - wheelPosition;
+    if (gap > halfPlay) {
+        wheelPosition = rotorPosition - halfPlay;
+    } else if (gap < -halfPlay) {
+        wheelPosition = rotorPosition + halfPlay;
+    }
+}
+
+void FilterWheelSimulator::applyHardStop() {
+    if (!config.hardStop) {
+        return;
+    }
+
+    // The wheel stops dead; the rotor can still cross the gear play
+    double upper = config.hardStopSteps;
+    double lower = upper - config.stepsPerRevolution;
+    double halfPlay = config.backlashSteps / 2.0;
+    if (wheelPosition > upper) {
+        wheelPosition = upper;
+        if (rotorPosition > upper + halfPlay) {
+            rotorPosition = upper + halfPlay;
+            if (rotorVelocity > 0.0) rotorVelocity = 0.0;
+        }
+    } else if (wheelPosition < lower) {
+        wheelPosition = lower;
+        if (rotorPosition < lower - halfPlay) {
+            rotorPosition = lower - halfPlay;
+            if (rotorVelocity < 0.0) rotorVelocity = 0.0;
+        }
+    }
+}
+
+float FilterWheelSimulator::nextGaussian() {
+    // xorshift32 + Box-Muller, deterministic for a given seed
+    auto next = [this]() {
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 17;
+        rngState ^= rngState << 5;
+        return (rngState + 1.0) / 4294967297.0;
+    };
+    double u1 = next();
+    double u2 = next();
+    return (float)(sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2));
+}
+
+#endif // ARDUINO_HOST
@@ -0,0 +1,155 @@
+#pragma once
+
+#ifdef ARDUINO_HOST
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/**
+ * Simulated mechanism parameters
+ * Angles and positions are expressed in motor steps unless noted;
+ * torques are expressed as the angular acceleration they produce (steps/s²).
+ */
+struct SimulatorConfig {
+    uint16_t stepsPerRevolution = 2048;   // Motor steps per wheel revolution (28BYJ-48)
+    uint16_t microsteps = 1;              // Step pulses per full step (driver microstepping)
+    float holdingAcceleration = 20000.0f; // Peak motor torque / total inertia
+    float viscousFriction = 40.0f;        // Velocity damping (1/s)
+    float coulombFriction = 2500.0f;      // Gearbox dry friction
+    float loadImbalance = 0.0f;           // Gravity torque amplitude of an unbalanced wheel
+    float backlashSteps = 6.0f;           // Total gear play between motor and wheel
+    float encoderOffsetDegrees = 37.0f;   // Magnet mounting angle relative to filter 1
+    bool encoderMirrored = true;          // Counts decrease as the wheel advances (see AS5600_INVERT_DIRECTION)
+    float encoderNoiseCounts = 0.7f;      // RMS sensor noise (counts)
+    float initialWheelSteps = 0.0f;       // Wheel position at power-up
+    bool hardStop = false;                // A pin blocks the wheel (travel limited to one turn)
+    float hardStopSteps = 0.0f;           // Wheel position of the stop going forward (backward: one turn less)
+    float stallGuardMinVelocity = 50.0f;  // Below this rotor speed the load reading fades to 0 (steps/s)
+    float stallGuardFilterTime = 0.02f;   // Averaging time of the load reading (s)
+    float stallGuardNoise = 8.0f;         // RMS noise of the load reading (counts)
+    float bindingFriction = 0.0f;         // Extra dry friction at a tight spot in the gear train
+    float bindingSteps = 0.0f;            // Wheel position where the tight spot starts
+    float bindingWidthSteps = 0.0f;       // Wheel travel over which it binds
+    uint32_t seed = 0x5EED1234;           // Noise generator seed (runs are reproducible)
+};
+
+/**
+ * Physics model of the filter wheel mechanism
+ *
+ * The rotor is pulled toward the commanded step by a sinusoidal stepper
+ * torque (one electrical period = 4 full steps), opposed by viscous and
+ * Coulomb friction and an optional gravity load. If the rotor lags more than
+ * two steps it falls into the next equilibrium, which is how missed steps
+ * appear. The wheel is dragged through a backlash deadband and read by a
+ * 12-bit encoder with quantization and Gaussian noise. An optional hard
+ * stop halts the wheel dead; the rotor then lags until it slips, which the
+ * StallGuard-like load reading reports. A tight spot adds friction over
+ * part of the turn, so the rotor slips there at speed.
+ *
+ * State is advanced lazily to Clock::system().micros() whenever it is observed or commanded.
+ */
+class FilterWheelSimulator {
+public:
+    explicit FilterWheelSimulator(const SimulatorConfig& config = SimulatorConfig());
+
+    /**
+     * Restore power-up state (also reseeds the noise generator)
+     */
+    void reset();
+
+    // ========================================
+    // MOTOR SIDE
+    // ========================================
+
+    /**
+     * Advance the commanded rotor position by one step pulse
+     * (1/microsteps of a full step)
+     * @param direction +1 forward, -1 backward
+     */
+    void step(int8_t direction);
+
+    /**
+     * Energize/de-energize the coils (no holding torque when off)
+     */
+    void setEnergized(bool energized);
+    bool isEnergized() const { return energized; }
+
+    // ========================================
+    // OBSERVATION
+    // ========================================
+
+    /**
+     * True wheel angle in degrees (0-360), no sensor effects
+     */
+    float getWheelAngle();
+
+    /**
+     * Sampled 12-bit encoder reading (quantized, noisy)
+     */
+    uint16_t readEncoderCounts();
+
+    /**
+     * Rotor velocity in steps/s
+     */
+    float getRotorVelocity();
+
+    /**
+     * Driver load reading like TMC2209 SG_RESULT (0-510, low = high load).
+     * Back-EMF based, as StallGuard is: scales with the averaged rotor
+     * speed in the stepping direction (0 when stalled, fading out below
+     * stallGuardMinVelocity) and falls with the averaged load angle.
+     */
+    uint16_t readStallGuard();
+
+    /**
+     * Signed step pulses lost so far (commanded minus achieved, whole pole slips)
+     */
+    long getMissedSteps();
+
+    /**
+     * Total step pulses commanded since reset
+     */
+    long getCommandedSteps() const { return commandedSteps; }
+
+    /**
+     * True once the rotor is stationary and no further motion is pending
+     */
+    bool isAtRest();
+
+    SimulatorConfig& getConfig() { return config; }
+
+    /**
+     * Integrate the model up to the given time (called implicitly by the accessors)
+     */
+    void advanceTo(unsigned long nowMicros);
+
+private:
+    static constexpr float INTEGRATION_STEP_S = 0.0001f;  // 100 µs
+
+    SimulatorConfig config;
+
+    long commandedSteps;    // step pulses
+    double rotorPosition;   // steps
+    double rotorVelocity;   // steps/s
+    double wheelPosition;   // steps
+    bool energized;
+    int8_t stepDirection;   // Direction of the last step pulse
+    double loadAverage;     // |sin(load angle)|, averaged over stallGuardFilterTime
+    double velocityAverage; // steps/s, averaged the same way
+    unsigned long lastUpdateMicros;
+    bool timeInitialized;
+    uint32_t rngState;
+
+    void integrate(float dt);
+    double commandedPosition() const;
+    float driveAcceleration() const;
+    float frictionAt() const;
+    void applyBacklash();
+    void applyHardStop();
+    void filterStallGuard(double dt);
+    bool isHeld() const;
+    float nextGaussian();
+    void advance();
+};
+
+#endif // ARDUINO_HOST
@@ -0,0 +1,124 @@
+#include "SimulatedEncoder.h"
+#include "../core/Clock.h"
+#include "../config.h"
+
+#ifdef ARDUINO_HOST
+
+SimulatedEncoder::SimulatedEncoder(FilterWheelSimulator& sim)
+    : simulator(sim)
+    , angleOffset(0.0f)
+    , available(false)
+    , movementDetected(false)
+    , directionInverted(false)
+    , previousRaw(0)
+    , rotationDirection(0)
+{
+}
+
+bool SimulatedEncoder::init() {
+    available = true;
+    previousRaw = getRawValue();
+    return true;
+}
+
+float SimulatedEncoder::getAngle() {
+    if (!available) {
+        return -1.0f;
+    }
+
+    return processSample(getRawValue());
+}
+
+float SimulatedEncoder::processSample(uint16_t rawValue) {
+    float angle = rawToAngle(rawValue);
+
+    int16_t delta = (int16_t)rawValue - (int16_t)previousRaw;
+    if (delta > 2048) {
+        delta -= 4096;
+    } else if (delta < -2048) {
+        delta += 4096;
+    }
+
+    const int16_t MOVEMENT_THRESHOLD = 5;
+    if (abs(delta) > MOVEMENT_THRESHOLD) {
+        movementDetected = true;
+        rotationDirection = (delta > 0) ? 1 : -1;
+        previousRaw = rawValue;
+    } else {
+        rotationDirection = 0;
+    }
+
+    return angle;
+}
+
+float SimulatedEncoder::rawToAngle(uint16_t rawValue) const {
+    float angle = rawValue * DEGREES_PER_COUNT;
+
+    #ifdef AS5600_INVERT_DIRECTION
+    #if AS5600_INVERT_DIRECTION
+    angle = 360.0f - angle;
+    #endif
+    #endif
+
+    if (directionInverted) {
+        angle = 360.0f - angle;
+    }
+
+    return normalizeAngle(angle - angleOffset);
+}
+
+uint16_t SimulatedEncoder::getRawValue() {
+    if (!available) {
+        return 0xFFFF;
+    }
+    return simulator.readEncoderCounts();
+}
+
+void SimulatedEncoder::setAngleOffset(float offset) {
+    angleOffset = normalizeAngle(offset);
+}
+
+bool SimulatedEncoder::performSelfTest() {
+    if (!available) {
+        return false;
+    }
+
+    uint16_t minVal = 0xFFFF;
+    uint16_t maxVal = 0;
+    for (int i = 0; i < 5; i++) {
+        uint16_t reading = getRawValue();
+        if (reading < minVal) minVal = reading;
+        if (reading > maxVal) maxVal = reading;
+        Clock::system().delay(10);
+    }
+
+    return (maxVal - minVal) <= 50;
+}
+
+int8_t SimulatedEncoder::getExpectedDirection(float targetAngle) {
+    float currentAngle = getAngle();
+    if (currentAngle < 0) {
+        return 0;
+    }
+
+    float diff = targetAngle - currentAngle;
+    while (diff > 180.0f) diff -= 360.0f;
+    while (diff < -180.0f) diff += 360.0f;
+
+    if (abs(diff) < 5.0f) {
+        return 0;
+    }
+    return (diff > 0) ? 1 : -1;
+}
+
+float SimulatedEncoder::normalizeAngle(float angle) {
+    while (angle < 0.0f) {
+        angle += 360.0f;
+    }
+    while (angle >= 360.0f) {
+        angle -= 360.0f;
+    }
+    return angle;
+}
+
+#endif // ARDUINO_HOST
@@ -0,0 +1,58 @@
+#pragma once
+
+#ifdef ARDUINO_HOST
+
+#include "../encoders/EncoderInterface.h"
+#include "FilterWheelSimulator.h"
+
+/**
+ * EncoderInterface backed by the FilterWheelSimulator
+ * Applies the same angle pipeline as AS5600Encoder (compile-time and
+ * runtime inversion, offset, movement/direction tracking) to simulated
+ * 12-bit readings.
+ */
+class SimulatedEncoder : public EncoderInterface {
+private:
+    FilterWheelSimulator& simulator;
+    float angleOffset;
+    bool available;
+    bool movementDetected;
+    bool directionInverted;
+    uint16_t previousRaw;
+    int8_t rotationDirection;
+
+    static constexpr uint16_t RESOLUTION = 4096;
+    static constexpr float DEGREES_PER_COUNT = 360.0f / RESOLUTION;
+
+    static float normalizeAngle(float angle);
+
+public:
+    explicit SimulatedEncoder(FilterWheelSimulator& sim);
+
+    bool init() override;
+    bool isAvailable() const override { return available; }
+    float getAngle() override;
+    uint16_t getRawValue() override;
+    float rawToAngle(uint16_t rawValue) const override;
+    uint16_t sampleRawValue() override { return getRawValue(); }
+    float processSample(uint16_t rawValue) override;
+    void setAngleOffset(float offset) override;
+    float getAngleOffset() const override { return angleOffset; }
+    uint16_t getResolution() const override { return RESOLUTION; }
+    const char* getEncoderType() const override { return "AS5600 (simulated)"; }
+    bool hasMovementDetected() override { return movementDetected; }
+    void resetMovementDetection() override { movementDetected = false; }
+    bool isHealthy() const override { return available; }
+    bool performSelfTest() override;
+    int8_t getRotationDirection() override { return rotationDirection; }
+    int8_t getExpectedDirection(float targetAngle) override;
+    void setDirectionInverted(bool inverted) override { directionInverted = inverted; }
+    bool isDirectionInverted() const override { return directionInverted; }
+
+    /**
+     * Simulate a disconnected sensor
+     */
+    void setAvailable(bool present) { available = present; }
+};
+
+#endif // ARDUINO_HOST
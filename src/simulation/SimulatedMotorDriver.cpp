@@ -0,0 +1,197 @@
+#include "SimulatedMotorDriver.h"
+#include "../core/Clock.h"
+
+#ifdef ARDUINO_HOST
+
+void SimulatedMotorDriver::SimulatedStepper::step(long step) {
+    int8_t direction = (_direction == DIRECTION_CW) ? 1 : -1;
+
+    // Same coil sequence as ULN2003Driver: even half steps are held back
+    if (coarse && (step & 1) == 0) {
+        heldSteps += direction;
+        return;
+    }
+    setCoarse(coarse);  // Pass on a held half step first
+    simulator.step(direction);
+}
+
+void SimulatedMotorDriver::SimulatedStepper::setCoarse(bool enabled) {
+    coarse = enabled;
+    while (heldSteps != 0) {
+        int8_t direction = (heldSteps > 0) ? 1 : -1;
+        simulator.step(direction);
+        heldSteps -= direction;
+    }
+}
+
+SimulatedMotorDriver::SimulatedMotorDriver(FilterWheelSimulator& sim)
+    : MotorDriver(&SimulatedMotorDriver::timerStep)
+    , simulator(sim)
+    , stepper(sim)
+    , motorEnabled(false)
+    , directionReversed(false)
+{
+}
+
+void SimulatedMotorDriver::init() {
+    setMaxSpeed(DEFAULT_MAX_SPEED);
+    setAcceleration(DEFAULT_ACCELERATION);
+    setSpeed(DEFAULT_SPEED);
+
+    disableMotor();
+}
+
+void SimulatedMotorDriver::move(long steps) {
+    if (directionReversed) {
+        steps = -steps;
+    }
+    stepper.move(steps);
+    enableMotor();
+}
+
+void SimulatedMotorDriver::moveTo(long position) {
+    if (directionReversed) {
+        position = -position;
+    }
+    stepper.moveTo(position);
+    enableMotor();
+}
+
+void SimulatedMotorDriver::setCurrentPosition(long position) {
+    if (directionReversed) {
+        position = -position;
+    }
+    stepper.setCurrentPosition(position);
+}
+
+long SimulatedMotorDriver::getCurrentPosition() const {
+    long pos = const_cast<SimulatedStepper&>(stepper).currentPosition();
+    return directionReversed ? -pos : pos;
+}
+
+long SimulatedMotorDriver::getTargetPosition() const {
+    long pos = const_cast<SimulatedStepper&>(stepper).targetPosition();
+    return directionReversed ? -pos : pos;
+}
+
+bool SimulatedMotorDriver::run() {
+    if (!motorEnabled) {
+        return false;
+    }
+    return stepper.run();
+}
+
+void SimulatedMotorDriver::runToPosition() {
+    if (!motorEnabled) {
+        return;
+    }
+    stepper.runToPosition();
+}
+
+bool SimulatedMotorDriver::isRunning() const {
+    return motorEnabled && const_cast<SimulatedStepper&>(stepper).isRunning();
+}
+
+void SimulatedMotorDriver::stepOnce(int8_t direction) {
+    if (!motorEnabled) {
+        return;
+    }
+    stepper.singleStep(directionReversed ? -direction : direction);
+}
+
+void SimulatedMotorDriver::timerStep(MotorDriver* driver, int8_t direction, bool coarse) {
+    SimulatedMotorDriver* self = static_cast<SimulatedMotorDriver*>(driver);
+    self->stepper.setCoarse(coarse && self->getMicrosteps() == 2);
+    self->stepOnce(direction);
+}
+
+void SimulatedMotorDriver::stop() {
+    stepper.stop();
+}
+
+void SimulatedMotorDriver::emergencyStop() {
+    stepper.stop();
+    disableMotor();
+}
+
+void SimulatedMotorDriver::setSpeed(float speed) {
+    stepper.setSpeed(speed * getMicrosteps());
+}
+
+void SimulatedMotorDriver::setMaxSpeed(float maxSpeed) {
+    stepper.setMaxSpeed(maxSpeed * getMicrosteps());
+}
+
+void SimulatedMotorDriver::setAcceleration(float acceleration) {
+    stepper.setAcceleration(acceleration * getMicrosteps());
+}
+
+float SimulatedMotorDriver::getSpeed() const {
+    return const_cast<SimulatedStepper&>(stepper).speed() / getMicrosteps();
+}
+
+float SimulatedMotorDriver::getMaxSpeed() const {
+    return const_cast<SimulatedStepper&>(stepper).maxSpeed() / getMicrosteps();
+}
+
+float SimulatedMotorDriver::getAcceleration() const {
+    return const_cast<SimulatedStepper&>(stepper).acceleration() / getMicrosteps();
+}
+
+void SimulatedMotorDriver::enableMotor() {
+    motorEnabled = true;
+    simulator.setEnergized(true);
+}
+
+void SimulatedMotorDriver::disableMotor() {
+    motorEnabled = false;
+    simulator.setEnergized(false);
+}
+
+bool SimulatedMotorDriver::isMotorEnabled() const {
+    return motorEnabled;
+}
+
+void SimulatedMotorDriver::setDirectionReversed(bool reversed) {
+    directionReversed = reversed;
+}
+
+bool SimulatedMotorDriver::isDirectionReversed() const {
+    return directionReversed;
+}
+
+uint16_t SimulatedMotorDriver::getMicrosteps() const {
+    return simulator.getConfig().microsteps;
+}
+
+void SimulatedMotorDriver::setCoarseStepping(bool coarse) {
+    stepper.setCoarse(coarse && getMicrosteps() == 2);
+}
+
+bool SimulatedMotorDriver::isStallDetected() const {
+    return simulator.readStallGuard() <= 2 * STALL_THRESHOLD;
+}
+
+// Same blocking semantics as ULN2003Driver::stepForward/stepBackward
+void SimulatedMotorDriver::stepForward(long steps) {
+    enableMotor();
+    stepper.setCurrentPosition(0);
+    stepper.moveTo(directionReversed ? -steps : steps);
+    runBlocking();
+}
+
+void SimulatedMotorDriver::stepBackward(long steps) {
+    enableMotor();
+    stepper.setCurrentPosition(0);
+    stepper.moveTo(directionReversed ? steps : -steps);
+    runBlocking();
+}
+
+void SimulatedMotorDriver::runBlocking() {
+    while (stepper.distanceToGo() != 0) {
+        stepper.run();
+        Clock::system().delay(1);
+    }
+}
+
+#endif // ARDUINO_HOST
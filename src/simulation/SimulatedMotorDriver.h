@@ -0,0 +1,106 @@
+#pragma once
+
+#ifdef ARDUINO_HOST
+
+#include "../drivers/MotorDriver.h"
+#include "FilterWheelSimulator.h"
+#include "../drivers/ProfileAccelStepper.h"
+
+/**
+ * MotorDriver backed by the FilterWheelSimulator
+ * Behaves like ULN2003Driver (same AccelStepper profile, same blocking
+ * stepForward/stepBackward), but step pulses drive the simulated rotor.
+ * With SimulatorConfig::microsteps above 1 it follows the TMC drivers'
+ * units instead: positions in microsteps, speeds in full steps. With 2
+ * it also has ULN2003Driver's coarse (full-step) travel. Stall detection
+ * reads the simulator's load model the way TMC2209Driver reads SG_RESULT.
+ */
+class SimulatedMotorDriver : public MotorDriver {
+private:
+    /**
+     * AccelStepper that forwards each generated step to the simulator
+     */
+    class SimulatedStepper : public ProfileAccelStepper {
+    public:
+        explicit SimulatedStepper(FilterWheelSimulator& sim)
+            : ProfileAccelStepper(AccelStepper::FUNCTION), simulator(sim), coarse(false), heldSteps(0) {}
+
+        void setCoarse(bool enabled);
+
+    protected:
+        void step(long step) override;
+
+    private:
+        FilterWheelSimulator& simulator;
+        bool coarse;
+        long heldSteps;     // Half steps not yet passed on in coarse mode
+    };
+
+    FilterWheelSimulator& simulator;
+    SimulatedStepper stepper;
+    bool motorEnabled;
+    bool directionReversed;
+
+    // The simulated 28BYJ-48 pulls out near 390 steps/s with the wheel on
+    // it, below ULN2003Driver's 500; keep the profile where it holds
+    static constexpr float DEFAULT_SPEED = 300.0;
+    static constexpr float DEFAULT_MAX_SPEED = 300.0;
+    static constexpr float DEFAULT_ACCELERATION = 200.0;
+    static constexpr uint16_t STALL_THRESHOLD = 20;    // Like SGTHRS: stall at a reading <= 2x this
+
+    void runBlocking();
+
+    static void timerStep(MotorDriver* driver, int8_t direction, bool coarse);
+
+public:
+    explicit SimulatedMotorDriver(FilterWheelSimulator& sim);
+
+    // MotorDriver interface implementation
+    void init() override;
+    void move(long steps) override;
+    void moveTo(long position) override;
+    void setCurrentPosition(long position) override;
+    long getCurrentPosition() const override;
+    long getTargetPosition() const override;
+
+    bool run() override;
+    void runToPosition() override;
+    bool isRunning() const override;
+    void stop() override;
+    void emergencyStop() override;
+    void stepOnce(int8_t direction) override;
+
+    void setSpeed(float speed) override;
+    void setMaxSpeed(float maxSpeed) override;
+    void setAcceleration(float acceleration) override;
+    float getSpeed() const override;
+    float getMaxSpeed() const override;
+    float getAcceleration() const override;
+
+    void enableMotor() override;
+    void disableMotor() override;
+    bool isMotorEnabled() const override;
+
+    void setDirectionReversed(bool reversed) override;
+    bool isDirectionReversed() const override;
+
+    bool supportsMicrostepping() const override { return getMicrosteps() > 1; }
+    bool supportsStallDetection() const override { return true; }
+    bool supportsCoolStep() const override { return false; }
+
+    const char* getDriverName() const override { return "Simulated"; }
+    const char* getDriverVersion() const override { return "1.0.0"; }
+
+    uint16_t getMicrosteps() const override;
+    void setCoarseStepping(bool coarse) override;
+
+    bool beginStallDetection() override { return true; }
+    bool isStallDetected() const override;
+
+    void stepForward(long steps) override;
+    void stepBackward(long steps) override;
+
+    FilterWheelSimulator& getSimulator() { return simulator; }
+};
+
+#endif // ARDUINO_HOST
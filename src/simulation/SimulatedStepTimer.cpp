@@ -0,0 +1,60 @@
+#include "SimulatedStepTimer.h"
+
+#ifdef ARDUINO_HOST
+
+SimulatedStepTimer::SimulatedStepTimer(SimulatedClock* clock)
+    : clock(clock)
+    , callback(nullptr)
+    , context(nullptr)
+    , pending(false)
+    , deadlineMicros(0)
+    , fireCount(0)
+{
+}
+
+SimulatedStepTimer::~SimulatedStepTimer() {
+    if (clock) {
+        clock->removeAlarm(this);
+    }
+}
+
+bool SimulatedStepTimer::begin(Callback cb, void* ctx) {
+    callback = cb;
+    context = ctx;
+    return true;
+}
+
+void SimulatedStepTimer::schedule(uint32_t delayMicros) {
+    if (delayMicros == 0) delayMicros = 1;
+
+    if (clock) {
+        clock->setAlarm(this, clock->getMicros64() + delayMicros);
+    } else {
+        deadlineMicros = Clock::system().micros() + delayMicros;
+        pending = true;
+    }
+}
+
+void SimulatedStepTimer::cancel() {
+    if (clock) {
+        clock->cancelAlarm(this);
+    }
+    pending = false;
+}
+
+void SimulatedStepTimer::poll() {
+    if (!pending || (long)(Clock::system().micros() - deadlineMicros) < 0) {
+        return;
+    }
+    pending = false;
+    onAlarm();
+}
+
+void SimulatedStepTimer::onAlarm() {
+    fireCount++;
+    if (callback) {
+        callback(context);
+    }
+}
+
+#endif // ARDUINO_HOST
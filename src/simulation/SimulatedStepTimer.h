@@ -0,0 +1,40 @@
+#pragma once
+
+#ifdef ARDUINO_HOST
+
+#include "../motion/StepTimer.h"
+#include "../core/Clock.h"
+
+/**
+ * StepTimer for host builds
+ * With a SimulatedClock the callback fires at its exact virtual deadline,
+ * interrupting whatever delay the firmware is in. Without one (wall-clock
+ * host build) due callbacks fire from poll() in the main loop.
+ */
+class SimulatedStepTimer : public StepTimer, private SimulatedClock::Alarm {
+public:
+    explicit SimulatedStepTimer(SimulatedClock* clock = nullptr);
+    ~SimulatedStepTimer() override;
+
+    bool begin(Callback callback, void* context) override;
+    void schedule(uint32_t delayMicros) override;
+    void cancel() override;
+    void poll() override;
+
+    /**
+     * Callbacks fired so far
+     */
+    uint32_t getFireCount() const { return fireCount; }
+
+private:
+    SimulatedClock* clock;
+    Callback callback;
+    void* context;
+    bool pending;                   // Wall-clock mode only
+    unsigned long deadlineMicros;   // Wall-clock mode only
+    uint32_t fireCount;
+
+    void onAlarm() override;
+};
+
+#endif // ARDUINO_HOST